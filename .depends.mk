@@ -0,0 +1,462 @@
+bin/test/asm/io/ReadableDescriptor bin/test/asmrun/io/ReadableDescriptor: \
+ test/asm/io/ReadableDescriptor.cxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ tools/asmcmp.hxx
+bin/test/asm/io/WritableDescriptor bin/test/asmrun/io/WritableDescriptor: \
+ test/asm/io/WritableDescriptor.cxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ tools/asmcmp.hxx
+bin/test/asm/net/TcpServerSocket bin/test/asmrun/net/TcpServerSocket: \
+ test/asm/net/TcpServerSocket.cxx include/metasys/net/TcpServerSocket.hxx \
+ include/metasys/net/TcpSocket.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx include/metasys/net/InetAddress.hxx \
+ include/metasys/net/bit.hxx include/metasys/net/TcpSocketDescriptor.hxx \
+ include/metasys/net/SocketDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx tools/asmcmp.hxx
+bin/test/asm/net/TcpSocket bin/test/asmrun/net/TcpSocket: \
+ test/asm/net/TcpSocket.cxx include/metasys/net/TcpSocket.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx include/metasys/net/InetAddress.hxx \
+ include/metasys/net/bit.hxx include/metasys/net/TcpSocketDescriptor.hxx \
+ include/metasys/net/SocketDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx tools/asmcmp.hxx
+bin/test/asm/sched/Process bin/test/asmrun/sched/Process: \
+ test/asm/sched/Process.cxx include/metasys/sched/Process.hxx \
+ include/metasys/io/Pipe.hxx include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/meta/AutoHolder.hxx \
+ include/metasys/meta/StaticOptional.hxx \
+ include/metasys/sched/EpollDescriptor.hxx \
+ include/metasys/sched/ProcessBehavior.hxx tools/asmcmp.hxx
+bin/test/asm/sched/Pthread bin/test/asmrun/sched/Pthread: \
+ test/asm/sched/Pthread.cxx include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx tools/asmcmp.hxx
+bin/test/asm/sys/FileDescriptor bin/test/asmrun/sys/FileDescriptor: \
+ test/asm/sys/FileDescriptor.cxx include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx tools/asmcmp.hxx
+bin/test/asm/sys/Result bin/test/asmrun/sys/Result: \
+ test/asm/sys/Result.cxx include/metasys/sys/Result.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx tools/asmcmp.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx include/metasys/sys/Trace.hxx
+bin/test/asm/sys/Trace bin/test/asmrun/sys/Trace: test/asm/sys/Trace.cxx \
+ include/metasys/sys/Trace.hxx tools/asmcmp.hxx
+bin/test/bench/fs/Directory: test/bench/fs/Directory.cxx \
+ include/metasys/fs/Directory.hxx include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx \
+ include/metasys/fs/DirectoryDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx tools/bench.hxx
+bin/test/bench/io/Pipe: test/bench/io/Pipe.cxx \
+ include/metasys/io/Pipe.hxx include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx tools/bench.hxx
+bin/test/bench/net/TcpSocket: test/bench/net/TcpSocket.cxx \
+ include/metasys/net/TcpSocket.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx include/metasys/net/InetAddress.hxx \
+ include/metasys/net/bit.hxx include/metasys/net/TcpSocketDescriptor.hxx \
+ include/metasys/net/SocketDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx tools/bench.hxx
+bin/test/bench/net/bit: test/bench/net/bit.cxx \
+ include/metasys/net/bit.hxx tools/bench.hxx
+bin/test/bench/sched/EpollDescriptor: \
+ test/bench/sched/EpollDescriptor.cxx \
+ include/metasys/sched/EpollDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ tools/bench.hxx
+bin/test/bench/sched/Process: test/bench/sched/Process.cxx \
+ include/metasys/sched/Process.hxx include/metasys/io/Pipe.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/meta/AutoHolder.hxx \
+ include/metasys/meta/StaticOptional.hxx \
+ include/metasys/sched/EpollDescriptor.hxx \
+ include/metasys/sched/ProcessBehavior.hxx tools/bench.hxx
+bin/test/bench/sched/Pthread: test/bench/sched/Pthread.cxx \
+ include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx tools/bench.hxx
+obj/fs/AlignedBufferPool.o obj/trace/fs/AlignedBufferPool.o: \
+ fs/AlignedBufferPool.cxx include/metasys/fs/AlignedBufferPool.hxx \
+ include/metasys/fs/Stat.hxx include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/fs/DirectReader.o obj/trace/fs/DirectReader.o: fs/DirectReader.cxx \
+ include/metasys/fs/DirectReader.hxx \
+ include/metasys/fs/AlignedBufferPool.hxx include/metasys/fs/Stat.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/io/InputStream.hxx \
+ include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx \
+ include/metasys/sched/PthreadRegistry.hxx
+obj/fs/Directory.o obj/trace/fs/Directory.o: fs/Directory.cxx \
+ include/metasys/fs/Directory.hxx include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/io/BufferPool.o obj/trace/io/BufferPool.o: io/BufferPool.cxx \
+ include/metasys/io/BufferPool.hxx include/metasys/sys/MemoryMapping.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/io/DelimiterScanner.o obj/trace/io/DelimiterScanner.o: \
+ io/DelimiterScanner.cxx include/metasys/io/DelimiterScanner.hxx \
+ include/metasys/sys/CpuFeatures.hxx
+obj/net/AddressInfo.o obj/trace/net/AddressInfo.o: net/AddressInfo.cxx \
+ include/metasys/net/AddressInfo.hxx \
+ include/metasys/net/ResolveException.hxx \
+ include/metasys/net/NetworkException.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/net/bit.o obj/trace/net/bit.o: net/bit.cxx \
+ include/metasys/net/bit.hxx include/metasys/sys/CpuFeatures.hxx
+obj/sched/PthreadRegistry.o obj/trace/sched/PthreadRegistry.o: \
+ sched/PthreadRegistry.cxx include/metasys/sched/PthreadRegistry.hxx \
+ include/metasys/sched/PthreadMutex.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/sched/Rseq.o obj/trace/sched/Rseq.o: sched/Rseq.cxx \
+ include/metasys/sched/Rseq.hxx
+obj/sys/MemoryMapping.o obj/trace/sys/MemoryMapping.o: \
+ sys/MemoryMapping.cxx include/metasys/sys/MemoryMapping.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/sys/SystemException.o obj/trace/sys/SystemException.o: \
+ sys/SystemException.cxx include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/ErrnoException.hxx
+obj/sys/Trace.o obj/trace/sys/Trace.o: sys/Trace.cxx \
+ include/metasys/sys/Trace.hxx include/metasys/sched/PthreadMutex.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/fs/DirectReader.o obj/trace/test/unit/fs/DirectReader.o: \
+ test/unit/fs/DirectReader.cxx include/metasys/fs/DirectReader.hxx \
+ include/metasys/fs/AlignedBufferPool.hxx include/metasys/fs/Stat.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/io/InputStream.hxx \
+ include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx include/metasys/fs/File.hxx \
+ include/metasys/io/ReadableDescriptor.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx
+obj/test/unit/fs/Directory.o obj/trace/test/unit/fs/Directory.o: \
+ test/unit/fs/Directory.cxx include/metasys/fs/Directory.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/fs/DirectoryDescriptor.o \
+ obj/trace/test/unit/fs/DirectoryDescriptor.o: \
+ test/unit/fs/DirectoryDescriptor.cxx \
+ include/metasys/fs/DirectoryDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/fs/DirectoryWalker.o \
+ obj/trace/test/unit/fs/DirectoryWalker.o: \
+ test/unit/fs/DirectoryWalker.cxx include/metasys/fs/DirectoryWalker.hxx \
+ include/metasys/fs/Directory.hxx include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/fs/Stat.hxx \
+ include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx \
+ include/metasys/sched/PthreadMutex.hxx \
+ include/metasys/sched/PthreadRegistry.hxx
+obj/test/unit/fs/File.o obj/trace/test/unit/fs/File.o: \
+ test/unit/fs/File.cxx include/metasys/fs/File.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx include/metasys/fs/Stat.hxx \
+ include/metasys/sys/ErrnoException.hxx
+obj/test/unit/fs/Statx.o obj/trace/test/unit/fs/Statx.o: \
+ test/unit/fs/Statx.cxx include/metasys/fs/Statx.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/io/BufferPool.o obj/trace/test/unit/io/BufferPool.o: \
+ test/unit/io/BufferPool.cxx include/metasys/io/BufferPool.hxx \
+ include/metasys/sys/MemoryMapping.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/ReceiveBuffer.hxx
+obj/test/unit/io/BufferedReader.o obj/trace/test/unit/io/BufferedReader.o: \
+ test/unit/io/BufferedReader.cxx include/metasys/io/BufferedReader.hxx \
+ include/metasys/io/DelimiterScanner.hxx \
+ include/metasys/io/InputStream.hxx include/metasys/io/Pipe.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx
+obj/test/unit/io/BufferedWriter.o obj/trace/test/unit/io/BufferedWriter.o: \
+ test/unit/io/BufferedWriter.cxx include/metasys/io/BufferedWriter.hxx \
+ include/metasys/io/OutputStream.hxx include/metasys/io/Pipe.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx
+obj/test/unit/io/DelimiterScanner.o \
+ obj/trace/test/unit/io/DelimiterScanner.o: \
+ test/unit/io/DelimiterScanner.cxx \
+ include/metasys/io/DelimiterScanner.hxx
+obj/test/unit/io/Pipe.o obj/trace/test/unit/io/Pipe.o: \
+ test/unit/io/Pipe.cxx include/metasys/io/Pipe.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx
+obj/test/unit/io/ReadableDescriptor.o \
+ obj/trace/test/unit/io/ReadableDescriptor.o: \
+ test/unit/io/ReadableDescriptor.cxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx
+obj/test/unit/io/WriteCoalescer.o obj/trace/test/unit/io/WriteCoalescer.o: \
+ test/unit/io/WriteCoalescer.cxx include/metasys/io/WriteCoalescer.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/Pipe.hxx include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/net/TcpSocket.hxx include/metasys/net/InetAddress.hxx \
+ include/metasys/net/bit.hxx include/metasys/net/TcpSocketDescriptor.hxx \
+ include/metasys/net/SocketDescriptor.hxx
+obj/test/unit/net/FrameReader.o obj/trace/test/unit/net/FrameReader.o: \
+ test/unit/net/FrameReader.cxx include/metasys/net/FrameReader.hxx \
+ include/metasys/net/bit.hxx include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/ErrnoException.hxx
+obj/test/unit/net/FrameWriter.o obj/trace/test/unit/net/FrameWriter.o: \
+ test/unit/net/FrameWriter.cxx include/metasys/net/FrameWriter.hxx \
+ include/metasys/net/FrameReader.hxx include/metasys/net/bit.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/sys/FileDescriptor.hxx
+obj/test/unit/net/InetAddress.o obj/trace/test/unit/net/InetAddress.o: \
+ test/unit/net/InetAddress.cxx include/metasys/net/InetAddress.hxx \
+ include/metasys/net/bit.hxx
+obj/test/unit/net/TcpServerSocket.o \
+ obj/trace/test/unit/net/TcpServerSocket.o: \
+ test/unit/net/TcpServerSocket.cxx \
+ include/metasys/net/TcpServerSocket.hxx \
+ include/metasys/net/TcpSocket.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx include/metasys/net/InetAddress.hxx \
+ include/metasys/net/bit.hxx include/metasys/net/TcpSocketDescriptor.hxx \
+ include/metasys/net/SocketDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/sys/ErrnoException.hxx
+obj/test/unit/net/TcpSocket.o obj/trace/test/unit/net/TcpSocket.o: \
+ test/unit/net/TcpSocket.cxx include/metasys/net/TcpSocket.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx include/metasys/net/InetAddress.hxx \
+ include/metasys/net/bit.hxx include/metasys/net/TcpSocketDescriptor.hxx \
+ include/metasys/net/SocketDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx
+obj/test/unit/net/bit.o obj/trace/test/unit/net/bit.o: \
+ test/unit/net/bit.cxx include/metasys/net/bit.hxx
+obj/test/unit/sched/EpollDescriptor.o \
+ obj/trace/test/unit/sched/EpollDescriptor.o: \
+ test/unit/sched/EpollDescriptor.cxx \
+ include/metasys/sched/EpollDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx
+obj/test/unit/sched/Process.o obj/trace/test/unit/sched/Process.o: \
+ test/unit/sched/Process.cxx include/metasys/sched/Process.hxx \
+ include/metasys/io/Pipe.hxx include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/meta/AutoHolder.hxx \
+ include/metasys/meta/StaticOptional.hxx \
+ include/metasys/sched/EpollDescriptor.hxx \
+ include/metasys/sched/ProcessBehavior.hxx
+obj/test/unit/sched/ProcessPool.o obj/trace/test/unit/sched/ProcessPool.o: \
+ test/unit/sched/ProcessPool.cxx include/metasys/sched/ProcessPool.hxx \
+ include/metasys/sched/Process.hxx include/metasys/io/Pipe.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/io/WritableDescriptor.hxx \
+ include/metasys/io/OutputStream.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/meta/AutoHolder.hxx \
+ include/metasys/meta/StaticOptional.hxx \
+ include/metasys/sched/EpollDescriptor.hxx \
+ include/metasys/sched/ProcessBehavior.hxx
+obj/test/unit/sched/Pthread.o obj/trace/test/unit/sched/Pthread.o: \
+ test/unit/sched/Pthread.cxx include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/sched/PthreadRegistry.o \
+ obj/trace/test/unit/sched/PthreadRegistry.o: \
+ test/unit/sched/PthreadRegistry.cxx \
+ include/metasys/sched/PthreadRegistry.hxx \
+ include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/sched/Rseq.o obj/trace/test/unit/sched/Rseq.o: \
+ test/unit/sched/Rseq.cxx include/metasys/sched/Rseq.hxx \
+ include/metasys/sched/PerCpu.hxx \
+ include/metasys/sched/PerCpuFreeList.hxx \
+ include/metasys/sched/PthreadMutex.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx \
+ include/metasys/sched/ShardedCounter.hxx
+obj/test/unit/sched/ShardedCounter.o \
+ obj/trace/test/unit/sched/ShardedCounter.o: \
+ test/unit/sched/ShardedCounter.cxx \
+ include/metasys/sched/ShardedCounter.hxx \
+ include/metasys/sched/PerCpu.hxx include/metasys/sched/Rseq.hxx \
+ include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/sched/ThisPthread.o obj/trace/test/unit/sched/ThisPthread.o: \
+ test/unit/sched/ThisPthread.cxx include/metasys/sched/ThisPthread.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/sched/ThreadLocal.o obj/trace/test/unit/sched/ThreadLocal.o: \
+ test/unit/sched/ThreadLocal.cxx include/metasys/sched/ThreadLocal.hxx \
+ include/metasys/sched/PthreadMutex.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx
+obj/test/unit/sys/ClosingDescriptor.o \
+ obj/trace/test/unit/sys/ClosingDescriptor.o: \
+ test/unit/sys/ClosingDescriptor.cxx \
+ include/metasys/sys/ClosingDescriptor.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/sys/FileDescriptor.o \
+ obj/trace/test/unit/sys/FileDescriptor.o: \
+ test/unit/sys/FileDescriptor.cxx include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx
+obj/test/unit/sys/MemoryMapping.o obj/trace/test/unit/sys/MemoryMapping.o: \
+ test/unit/sys/MemoryMapping.cxx include/metasys/sys/MemoryMapping.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx
+obj/test/unit/sys/Result.o obj/trace/test/unit/sys/Result.o: \
+ test/unit/sys/Result.cxx include/metasys/sys/Result.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx \
+ include/metasys/io/ReadableDescriptor.hxx \
+ include/metasys/io/InputStream.hxx \
+ include/metasys/sys/FileDescriptor.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/sched/Pthread.hxx \
+ include/metasys/sched/PthreadBehavior.hxx \
+ include/metasys/sys/ErrnoException.hxx
+obj/test/unit/sys/Slab.o obj/trace/test/unit/sys/Slab.o: \
+ test/unit/sys/Slab.cxx include/metasys/sys/Slab.hxx \
+ include/metasys/sys/MemoryMapping.hxx \
+ include/metasys/sys/FileDescriptor.hxx \
+ include/metasys/sys/SystemException.hxx \
+ include/metasys/sys/Exception.hxx \
+ include/metasys/sched/EpollDescriptor.hxx \
+ include/metasys/sys/ClosingDescriptor.hxx include/metasys/sys/Trace.hxx \
+ include/metasys/sys/Arena.hxx
+obj/test/unit/sys/Trace.o obj/trace/test/unit/sys/Trace.o: \
+ test/unit/sys/Trace.cxx include/metasys/sys/Trace.hxx
@@ -23,7 +23,7 @@ ACXXFLAGS := -Wall -Wextra -O3 -std=c++20 -g -DNDEBUG
 
 define cmd-aldcxx
   $(call cmd-print,  LDCXX   $(strip $(1)))
-  $(Q)g++ $(ACXXFLAGS) -o $(1) $(2) $(addprefix -I, $(5)) \
+  $(Q)g++ $(ACXXFLAGS) $(6) -o $(1) $(2) $(addprefix -I, $(5)) \
     $(addprefix -L, $(4)) $(addprefix -l, $(3))
 endef
 
@@ -39,7 +39,7 @@ endef
 
 define cmd-ccxx
   $(call cmd-print,  CCXX    $(strip $(1)))
-  $(Q)g++ $(CXXFLAGS) -c $(2) -o $(1) $(addprefix -I, $(3))
+  $(Q)g++ $(CXXFLAGS) $(4) -c $(2) -o $(1) $(addprefix -I, $(3))
 endef
 
 define cmd-clean
@@ -49,7 +49,8 @@ endef
 
 define cmd-depcxx
   $(call cmd-info,  DEPCXX  $(strip $(1)))
-  $(Q)g++ $(CXXFLAGS) -MM $(3) -o $(1) -MT $(2) $(addprefix -I, $(4))
+  $(Q)g++ $(CXXFLAGS) -MM $(3) -o $(1) $(addprefix -MT, $(2)) \
+    $(addprefix -I, $(4))
 endef
 
 define cmd-install
@@ -0,0 +1,65 @@
+#include <metasys/fs/AlignedBufferPool.hxx>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+
+using metasys::AlignedBufferPool;
+
+
+AlignedBufferPool::AlignedBufferPool(size_t bufsize, size_t count,
+				     size_t align)
+	: _bufsize(((bufsize + align - 1) / align) * align), _count(count)
+{
+	size_t i;
+
+	assert(align > 0);
+	assert((align & (align - 1)) == 0);
+	assert(count > 0);
+
+	_base = std::aligned_alloc(align, _bufsize * _count);
+
+	if (_base == nullptr) [[unlikely]]
+		throw std::bad_alloc();
+
+	_free.reserve(_count);
+
+	for (i = _count; i > 0; i--)
+		_free.push_back(static_cast<char *> (_base) +
+				(i - 1) * _bufsize);
+}
+
+AlignedBufferPool::AlignedBufferPool(AlignedBufferPool &&other) noexcept
+	: _base(other._base), _bufsize(other._bufsize), _count(other._count)
+	, _free(std::move(other._free))
+{
+	other._base = nullptr;
+	other._bufsize = 0;
+	other._count = 0;
+}
+
+AlignedBufferPool::~AlignedBufferPool()
+{
+	std::free(_base);
+}
+
+AlignedBufferPool &AlignedBufferPool::operator=(AlignedBufferPool &&other)
+	noexcept
+{
+	if (other._base != _base) [[likely]]
+		std::free(_base);
+
+	_base = other._base;
+	_bufsize = other._bufsize;
+	_count = other._count;
+	_free = std::move(other._free);
+
+	other._base = nullptr;
+	other._bufsize = 0;
+	other._count = 0;
+
+	return *this;
+}
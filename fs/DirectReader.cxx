@@ -0,0 +1,71 @@
+#include <metasys/fs/DirectReader.hxx>
+#include <metasys/sched/PthreadRegistry.hxx>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+
+
+using metasys::DirectReader;
+using metasys::PthreadRegistry;
+
+
+void DirectReader::_work() noexcept
+{
+	off_t offset = _offset;
+	size_t bufsize = _pool->bufsize();
+	size_t i = 0;
+	ssize_t ret;
+	int state;
+
+	PthreadRegistry::enlist("directreader");
+
+	while (true) {
+		Slot &slot = _slots[i];
+
+		while ((state = slot.state.load(std::memory_order_acquire))
+		       == FULL)
+			slot.state.wait(FULL, std::memory_order_acquire);
+
+		if (state == STOP)
+			return;
+
+		do {
+			ret = ::pread(_fd, slot.buf, bufsize, offset);
+		} while ((ret < 0) && (errno == EINTR));
+
+		slot.len = ret;
+		slot.err = errno;
+
+		state = EMPTY;
+		if (slot.state.compare_exchange_strong
+		    (state, FULL, std::memory_order_release) == false)
+			return;
+
+		slot.state.notify_one();
+
+		if (ret < static_cast<ssize_t> (bufsize))
+			return;
+
+		offset += ret;
+		i ^= 1;
+	}
+}
+
+void DirectReader::stop() noexcept
+{
+	assert(valid());
+
+	_slots[0].state.store(STOP, std::memory_order_release);
+	_slots[0].state.notify_one();
+	_slots[1].state.store(STOP, std::memory_order_release);
+	_slots[1].state.notify_one();
+
+	_worker.join();
+
+	_pool->release(_slots[1].buf);
+	_pool->release(_slots[0].buf);
+	_pool = nullptr;
+	_eof = true;
+}
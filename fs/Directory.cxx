@@ -3,6 +3,8 @@
 #include <dirent.h>
 #include <sys/types.h>
 
+#include <cassert>
+
 
 using metasys::Directory;
 
@@ -34,3 +36,53 @@ DIR *Directory::reset(DIR *dh) noexcept
 
 	return tmp;
 }
+
+Directory::Iterator::Iterator(DIR *dh) noexcept
+	: _dh(dh), _entry(::readdir(dh))
+{
+}
+
+Directory::Iterator &Directory::Iterator::operator++() noexcept
+{
+	_entry = ::readdir(_dh);
+	return *this;
+}
+
+Directory::Iterator Directory::Iterator::operator++(int) noexcept
+{
+	Iterator ret = *this;
+	++(*this);
+	return ret;
+}
+
+bool Directory::Iterator::operator==(const Iterator &other) const noexcept
+{
+	return (_entry == other._entry);
+}
+
+bool Directory::Iterator::operator!=(const Iterator &other) const noexcept
+{
+	return !(*this == other);
+}
+
+Directory::Entry &Directory::Iterator::operator*() const noexcept
+{
+	return *_entry;
+}
+
+Directory::Entry *Directory::Iterator::operator->() const noexcept
+{
+	return _entry;
+}
+
+Directory::Iterator Directory::begin() noexcept
+{
+	assert(valid());
+
+	return Iterator(_dh);
+}
+
+Directory::Iterator Directory::end() noexcept
+{
+	return Iterator();
+}
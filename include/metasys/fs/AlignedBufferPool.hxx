@@ -0,0 +1,142 @@
+#ifndef _INCLUDE_METASYS_FS_ALIGNEDBUFFERPOOL_HXX_
+#define _INCLUDE_METASYS_FS_ALIGNEDBUFFERPOOL_HXX_
+
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <vector>
+
+#include <metasys/fs/Stat.hxx>
+#include <metasys/sys/FileDescriptor.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+namespace metasys {
+
+
+// Fixed set of equally sized buffers whose address and size are multiple
+// of the same alignment, as required by `O_DIRECT` I/O.
+// All the buffers are carved from a single allocation.
+// The pool is not thread-safe.
+//
+class AlignedBufferPool
+{
+	void                *_base;
+	size_t               _bufsize;
+	size_t               _count;
+	std::vector<void *>  _free;
+
+
+ public:
+	AlignedBufferPool() noexcept
+		: _base(nullptr), _bufsize(0), _count(0)
+	{
+	}
+
+	// Build a pool of `count` buffers of `bufsize` bytes aligned on
+	// `align` bytes.
+	// The `bufsize` is rounded up to a multiple of `align`.
+	//
+	AlignedBufferPool(size_t bufsize, size_t count, size_t align);
+
+	AlignedBufferPool(const AlignedBufferPool &other) = delete;
+	AlignedBufferPool(AlignedBufferPool &&other) noexcept;
+
+	~AlignedBufferPool();
+
+	AlignedBufferPool &operator=(const AlignedBufferPool &other) = delete;
+	AlignedBufferPool &operator=(AlignedBufferPool &&other) noexcept;
+
+
+	size_t bufsize() const noexcept
+	{
+		return _bufsize;
+	}
+
+	size_t count() const noexcept
+	{
+		return _count;
+	}
+
+	size_t available() const noexcept
+	{
+		return _free.size();
+	}
+
+	// Return a free buffer or `nullptr` if they are all in use.
+	//
+	void *acquire() noexcept
+	{
+		void *ret;
+
+		if (_free.empty()) [[unlikely]]
+			return nullptr;
+
+		ret = _free.back();
+		_free.pop_back();
+
+		return ret;
+	}
+
+	void release(void *buf) noexcept
+	{
+		assert(buf >= _base);
+		assert(buf < (static_cast<char *> (_base) + _bufsize * _count));
+		assert(_free.size() < _count);
+
+		_free.push_back(buf);
+	}
+
+
+	// Alignment to use for direct I/O on `fd`, that is the preferred block
+	// size of its filesystem.
+	//
+	template<typename ErrHandler>
+	static auto alignment(int fd, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		Stat st;
+
+		if (st.scan(fd, [](int r) { return r; }) < 0) [[unlikely]]
+			return handler(-1);
+
+		return handler(static_cast<long> (st.st_blksize));
+	}
+
+	template<typename ErrHandler>
+	static auto alignment(const FileDescriptor &fd, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return alignment(fd.value(), std::forward<ErrHandler>(handler));
+	}
+
+	static size_t alignment(int fd)
+	{
+		return alignment(fd, [](long ret) {
+			if (ret < 0) [[unlikely]]
+				throwalignment();
+			return static_cast<size_t> (ret);
+		});
+	}
+
+	static size_t alignment(const FileDescriptor &fd)
+	{
+		return alignment(fd.value());
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwalignment()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+
+		SystemException::throwErrno();
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef _INCLUDE_METASYS_FS_DIRECTREADER_HXX_
+#define _INCLUDE_METASYS_FS_DIRECTREADER_HXX_
+
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <metasys/fs/AlignedBufferPool.hxx>
+#include <metasys/io/InputStream.hxx>
+#include <metasys/sched/Pthread.hxx>
+#include <metasys/sched/PthreadBehavior.hxx>
+#include <metasys/sys/FileDescriptor.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+namespace metasys {
+
+
+// Sequential reader for a file opened with `O_DIRECT`.
+// Two buffers from an `AlignedBufferPool` are filled alternately by a
+// background thread with `pread()`, so one block is read from the device
+// while the caller consumes the other.
+// The file descriptor is not owned by the reader and must remain open
+// until `stop()`.
+//
+class DirectReader
+{
+	static constexpr int EMPTY = 0;  // consumed, to be filled
+	static constexpr int FULL  = 1;  // filled, to be consumed
+	static constexpr int STOP  = 2;  // reader stopping
+
+
+	struct alignas(64) Slot
+	{
+		std::atomic<int>   state;
+		void              *buf;
+		ssize_t            len;
+		int                err;
+	};
+
+
+	using Worker = Pthread<void, PthreadBehavior::Nothing>;
+
+
+	Slot                _slots[2];
+	int                 _fd;
+	off_t               _offset;
+	AlignedBufferPool  *_pool;
+	Worker              _worker;
+
+	size_t              _cur;
+	size_t              _pos;
+	bool                _eof;
+
+
+	void _work() noexcept;
+
+	template<typename ErrHandler>
+	auto _start(ErrHandler &&handler) noexcept (noexcept (handler(-1)))
+	{
+		int ret;
+
+		if ((_slots[0].buf = _pool->acquire()) == nullptr) [[unlikely]]
+			goto err;
+		if ((_slots[1].buf = _pool->acquire()) == nullptr) [[unlikely]]
+			goto err_release;
+
+		_slots[0].state.store(EMPTY, std::memory_order_relaxed);
+		_slots[1].state.store(EMPTY, std::memory_order_relaxed);
+		_cur = 0;
+		_pos = 0;
+		_eof = false;
+
+		ret = _worker.create<&DirectReader::_work>(this, [](int r) {
+			return r;
+		});
+
+		if (ret == 0) [[likely]]
+			return handler(0);
+
+		_pool->release(_slots[1].buf);
+		_pool->release(_slots[0].buf);
+		_pool = nullptr;
+		errno = ret;
+		return handler(-1);
+	 err_release:
+		_pool->release(_slots[0].buf);
+	 err:
+		_pool = nullptr;
+		errno = ENOBUFS;
+		return handler(-1);
+	}
+
+
+ public:
+	DirectReader() noexcept
+		: _fd(-1), _offset(0), _pool(nullptr), _cur(0), _pos(0)
+		, _eof(true)
+	{
+	}
+
+	DirectReader(const DirectReader &other) = delete;
+	DirectReader(DirectReader &&other) = delete;
+
+	~DirectReader()
+	{
+		if (valid())
+			stop();
+	}
+
+	DirectReader &operator=(const DirectReader &other) = delete;
+	DirectReader &operator=(DirectReader &&other) = delete;
+
+
+	bool valid() const noexcept
+	{
+		return (_pool != nullptr);
+	}
+
+
+	// Start reading `fd` from `offset` which must be aligned like the
+	// buffers of `pool`.
+	// Two buffers are taken from `pool` until `stop()`.
+	//
+	template<typename ErrHandler>
+	auto start(int fd, AlignedBufferPool &pool, off_t offset,
+		   ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid() == false);
+		assert(fd >= 0);
+
+		_fd = fd;
+		_offset = offset;
+		_pool = &pool;
+
+		return _start(std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto start(const FileDescriptor &fd, AlignedBufferPool &pool,
+		   off_t offset, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return start(fd.value(), pool, offset,
+			     std::forward<ErrHandler>(handler));
+	}
+
+	void start(int fd, AlignedBufferPool &pool, off_t offset = 0)
+	{
+		start(fd, pool, offset, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwstart();
+		});
+	}
+
+	void start(const FileDescriptor &fd, AlignedBufferPool &pool,
+		   off_t offset = 0)
+	{
+		start(fd.value(), pool, offset);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwstart()
+	{
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
+
+
+	// Wait for the background thread and give the buffers back to the
+	// pool.
+	//
+	void stop() noexcept;
+
+
+	template<typename ErrHandler>
+	auto read(void *dest, size_t len, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		Slot &slot = _slots[_cur];
+		size_t n;
+
+		assert(valid());
+
+		if (_eof)
+			return handler(0);
+
+		while (slot.state.load(std::memory_order_acquire) == EMPTY)
+			slot.state.wait(EMPTY, std::memory_order_acquire);
+
+		if (slot.len < 0) [[unlikely]] {
+			errno = slot.err;
+			return handler(-1);
+		}
+
+		n = static_cast<size_t> (slot.len) - _pos;
+		if (n > len)
+			n = len;
+
+		std::memcpy(dest, static_cast<char *> (slot.buf) + _pos, n);
+		_pos += n;
+
+		if (_pos == static_cast<size_t> (slot.len)) {
+			// A short read means the end of file has been reached
+			// and the background thread has exited.
+			if (_pos < _pool->bufsize()) {
+				_eof = true;
+			} else {
+				_pos = 0;
+				_cur ^= 1;
+				slot.state.store(EMPTY, std::memory_order_release);
+				slot.state.notify_one();
+			}
+		}
+
+		return handler(static_cast<ssize_t> (n));
+	}
+
+	size_t read(void *dest, size_t len)
+	{
+		return read(dest, len, [](ssize_t ret) {
+			if (ret < 0) [[unlikely]]
+				throwread();
+			return static_cast<size_t> (ret);
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwread()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+
+		SystemException::throwErrno();
+	}
+};
+
+static_assert (BatchInputStream<DirectReader>);
+
+
+}
+
+
+#endif
@@ -156,6 +156,7 @@ class Directory
 		});
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void openthrow()
 	{
 		assert(errno != EBADF);
@@ -183,6 +184,38 @@ class Directory
 		// The only possible error is EBADF
 		return ::readdir(_dh);
 	}
+
+
+	class Iterator
+	{
+		DIR    *_dh;
+		Entry  *_entry;
+
+
+	 public:
+		constexpr Iterator() noexcept
+			: _dh(nullptr), _entry(nullptr)
+		{
+		}
+
+		explicit Iterator(DIR *dh) noexcept;
+
+		constexpr Iterator(const Iterator &other) noexcept = default;
+		Iterator(Iterator &&other) noexcept = default;
+
+		Iterator &operator=(const Iterator &other) noexcept = default;
+		Iterator &operator=(Iterator &&other) noexcept = default;
+
+		Iterator &operator++() noexcept;
+		Iterator operator++(int) noexcept;
+		bool operator==(const Iterator &other) const noexcept;
+		bool operator!=(const Iterator &other) const noexcept;
+		Entry &operator*() const noexcept;
+		Entry *operator->() const noexcept;
+	};
+
+	Iterator begin() noexcept;
+	Iterator end() noexcept;
 };
 
 
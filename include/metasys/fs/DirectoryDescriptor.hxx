@@ -0,0 +1,317 @@
+#ifndef _INCLUDE_METASYS_FS_DIRECTORYDESCRIPTOR_HXX_
+#define _INCLUDE_METASYS_FS_DIRECTORYDESCRIPTOR_HXX_
+
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <metasys/sys/ClosingDescriptor.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+namespace metasys {
+
+
+// View over the entries written by `getdents64()` in a caller buffer.
+// The `d_type` field of each entry is filled by most filesystems which
+// lets callers skip a `stat()` unless it is `DT_UNKNOWN`.
+//
+class DirectoryBatch
+{
+ public:
+	using Entry = struct dirent64;
+
+
+ private:
+	const uint8_t  *_buf;
+	size_t          _len;
+
+
+ public:
+	constexpr DirectoryBatch() noexcept
+		: _buf(nullptr), _len(0)
+	{
+	}
+
+	constexpr DirectoryBatch(const void *buf, size_t len) noexcept
+		: _buf(static_cast<const uint8_t *> (buf)), _len(len)
+	{
+	}
+
+	constexpr DirectoryBatch(const DirectoryBatch &other) noexcept =
+		default;
+
+	DirectoryBatch &operator=(const DirectoryBatch &other) noexcept =
+		default;
+
+
+	constexpr size_t size() const noexcept
+	{
+		return _len;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return (_len == 0);
+	}
+
+
+	class Iterator
+	{
+		const uint8_t  *_pos;
+
+
+	 public:
+		constexpr Iterator() noexcept
+			: _pos(nullptr)
+		{
+		}
+
+		explicit constexpr Iterator(const uint8_t *pos) noexcept
+			: _pos(pos)
+		{
+		}
+
+		constexpr Iterator(const Iterator &other) noexcept = default;
+
+		Iterator &operator=(const Iterator &other) noexcept = default;
+
+		Iterator &operator++() noexcept
+		{
+			_pos += (**this).d_reclen;
+			return *this;
+		}
+
+		Iterator operator++(int) noexcept
+		{
+			Iterator ret = *this;
+			++(*this);
+			return ret;
+		}
+
+		constexpr bool operator==(const Iterator &other) const noexcept
+		{
+			return (_pos == other._pos);
+		}
+
+		constexpr bool operator!=(const Iterator &other) const noexcept
+		{
+			return !(*this == other);
+		}
+
+		const Entry &operator*() const noexcept
+		{
+			return *reinterpret_cast<const Entry *> (_pos);
+		}
+
+		const Entry *operator->() const noexcept
+		{
+			return reinterpret_cast<const Entry *> (_pos);
+		}
+	};
+
+	constexpr Iterator begin() const noexcept
+	{
+		return Iterator(_buf);
+	}
+
+	constexpr Iterator end() const noexcept
+	{
+		return Iterator(_buf + _len);
+	}
+};
+
+
+// Directory opened as a plain file descriptor and read in bulk with
+// `getdents64()`.
+// Unlike `Directory`, the entries are not copied in an internal libc buffer
+// one at a time: each `read()` fills as many entries as the caller buffer
+// can hold in a single system call.
+//
+class DirectoryDescriptor : public ClosingDescriptor
+{
+ public:
+	using ClosingDescriptor::ClosingDescriptor;
+
+	static constexpr int OPEN_FLAGS = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+
+
+	template<typename ErrHandler>
+	auto open(int dirfd, const char *path, int flags,
+		  ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid() == false);
+
+		reset(::openat(dirfd, path, OPEN_FLAGS | flags));
+
+		return handler(value());
+	}
+
+	template<typename ErrHandler>
+	auto open(const FileDescriptor &dir, const char *path, int flags,
+		  ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return open(dir.value(), path, flags,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto open(const char *path, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return open(AT_FDCWD, path, 0,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto open(const std::string &path, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return open(path.c_str(), std::forward<ErrHandler>(handler));
+	}
+
+	template<typename Dir>
+	void open(Dir &&dir, const char *path, int flags = 0)
+	{
+		open(std::forward<Dir>(dir), path, flags, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwopen();
+		});
+	}
+
+	template<typename Path>
+	void open(Path &&path)
+	{
+		open(std::forward<Path>(path), [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwopen();
+		});
+	}
+
+	template<typename ErrHandler>
+	static DirectoryDescriptor openinit(int dirfd, const char *path,
+					    int flags, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		int fd = ::openat(dirfd, path, OPEN_FLAGS | flags);
+
+		handler(fd);
+
+		return DirectoryDescriptor(fd);
+	}
+
+	template<typename ErrHandler>
+	static DirectoryDescriptor openinit(const char *path,
+					    ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return openinit(AT_FDCWD, path, 0,
+				std::forward<ErrHandler>(handler));
+	}
+
+	static DirectoryDescriptor openinit(int dirfd, const char *path,
+					    int flags = 0)
+	{
+		return openinit(dirfd, path, flags, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwopen();
+		});
+	}
+
+	static DirectoryDescriptor openinit(const char *path)
+	{
+		return openinit(AT_FDCWD, path, 0);
+	}
+
+	static DirectoryDescriptor openinit(const std::string &path)
+	{
+		return openinit(path.c_str());
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwopen()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
+
+
+	template<typename ErrHandler>
+	auto read(void *dest, size_t len, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+
+		return handler(::getdents64(value(), dest, len));
+	}
+
+	size_t read(void *dest, size_t len)
+	{
+		ssize_t ret;
+
+		assert(valid());
+
+	retry:
+		if ((ret = ::getdents64(value(), dest, len)) < 0) [[unlikely]] {
+			if (errno == EINTR)
+				goto retry;
+			throwread();
+		}
+
+		return ((size_t) ret);
+	}
+
+	// Fill `dest` with as many entries as possible and return a view on
+	// them. An empty batch indicates the end of the directory.
+	//
+	DirectoryBatch readbatch(void *dest, size_t len)
+	{
+		return DirectoryBatch(dest, read(dest, len));
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwread()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+		assert(errno != ENOTDIR);
+
+		SystemException::throwErrno();
+	}
+
+
+	template<typename ErrHandler>
+	auto rewind(ErrHandler &&handler) noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+
+		return handler(::lseek(value(), 0, SEEK_SET));
+	}
+
+	void rewind()
+	{
+		rewind([](off_t ret) {
+			if (ret < 0) [[unlikely]]
+				SystemException::throwErrno();
+		});
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,345 @@
+#ifndef _INCLUDE_METASYS_FS_DIRECTORYWALKER_HXX_
+#define _INCLUDE_METASYS_FS_DIRECTORYWALKER_HXX_
+
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <concepts>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <metasys/fs/Directory.hxx>
+#include <metasys/fs/Stat.hxx>
+#include <metasys/sched/Pthread.hxx>
+#include <metasys/sched/PthreadMutex.hxx>
+#include <metasys/sched/PthreadRegistry.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+namespace metasys {
+
+
+namespace detail {
+
+
+template<typename T>
+concept WalkVisitor = std::invocable<T &, int, const char *, const Stat &>;
+
+
+}
+
+
+// Recursive directory walker processing subdirectories in parallel.
+// For every entry below the root, the visitor is called with the file
+// descriptor of the parent directory, the entry name and its `Stat`
+// obtained with `AT_SYMLINK_NOFOLLOW`, so that callers can use `openat()`
+// and friends without building paths.
+// If the visitor returns `false` for a directory, this directory is not
+// walked.
+// The visitor is called concurrently from several threads. If it throws,
+// the walk stops and `walk()` rethrows the first exception once all the
+// threads are done.
+//
+template<detail::WalkVisitor Visitor>
+class DirectoryWalker
+{
+	// Past this number of queued directories, a thread walks the next
+	// subdirectories itself instead of queueing them so the number of
+	// open file descriptors remains bounded.
+	static constexpr size_t QUEUE_PER_THREAD = 64;
+
+	static constexpr int OPEN_FLAGS =
+		O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC;
+
+
+	using Worker = Pthread<void, PthreadBehavior::Nothing>;
+
+
+	Visitor               _visitor;
+	size_t                _nthreads;
+
+	PthreadMutex          _lock;
+	std::vector<int>      _queue;
+	std::atomic<size_t>   _pending;
+	std::atomic<uint64_t> _ticket;
+	std::atomic<int>      _error;
+	std::atomic<bool>     _stop;
+	std::exception_ptr    _exception;
+
+
+	bool _visit(int dirfd, const char *name, const Stat &st)
+	{
+		using Ret = std::invoke_result_t<Visitor &, int, const char *,
+						 const Stat &>;
+
+		if constexpr (std::convertible_to<Ret, bool>) {
+			return std::invoke(_visitor, dirfd, name, st);
+		} else {
+			std::invoke(_visitor, dirfd, name, st);
+			return true;
+		}
+	}
+
+	void _notify() noexcept
+	{
+		_ticket.fetch_add(1, std::memory_order_release);
+		_ticket.notify_all();
+	}
+
+	bool _push(int fd) noexcept
+	{
+		bool ret = false;
+
+		_lock.lock();
+
+		if (_queue.size() < (QUEUE_PER_THREAD * _nthreads)) {
+			_queue.push_back(fd);
+			_pending.fetch_add(1, std::memory_order_relaxed);
+			ret = true;
+		}
+
+		_lock.unlock();
+
+		if (ret)
+			_notify();
+
+		return ret;
+	}
+
+	int _pop() noexcept
+	{
+		int ret = -1;
+
+		_lock.lock();
+
+		if (_queue.empty() == false) {
+			ret = _queue.back();
+			_queue.pop_back();
+		}
+
+		_lock.unlock();
+
+		return ret;
+	}
+
+	void _fail() noexcept
+	{
+		int expected = 0;
+
+		_error.compare_exchange_strong(expected, errno);
+	}
+
+	void _abort(std::exception_ptr exception) noexcept
+	{
+		_lock.lock();
+
+		if (_exception == nullptr)
+			_exception = std::move(exception);
+
+		_lock.unlock();
+
+		_stop.store(true, std::memory_order_relaxed);
+	}
+
+	void _walk(int fd)
+	{
+		Directory dir = Directory(fd, [](DIR *) {});
+		auto passthrough = [](int r) { return r; };
+		int subfd;
+		Stat st;
+
+		if (dir.valid() == false) [[unlikely]] {
+			_fail();
+			::close(fd);
+			return;
+		}
+
+		for (const Directory::Entry &entry : dir) {
+			const char *name = entry.d_name;
+
+			if (_stop.load(std::memory_order_relaxed)) [[unlikely]]
+				break;
+
+			if ((name[0] == '.') && ((name[1] == '\0') ||
+			    ((name[1] == '.') && (name[2] == '\0'))))
+				continue;
+
+			// Entries removed during the walk are not errors.
+			if (st.scan(fd, name, Stat::SYMLINK_NOFOLLOW,
+				    passthrough) < 0) [[unlikely]] {
+				if (errno != ENOENT)
+					_fail();
+				continue;
+			}
+
+			if (_visit(fd, name, st) == false)
+				continue;
+
+			if (S_ISDIR(st.st_mode) == false)
+				continue;
+
+			if ((subfd = ::openat(fd, name, OPEN_FLAGS)) < 0) {
+				if (errno != ENOENT)
+					_fail();
+				continue;
+			}
+
+			if (_push(subfd) == false)
+				_walk(subfd);
+		}
+	}
+
+	void _work() noexcept
+	{
+		uint64_t ticket;
+		int fd;
+
+		while (true) {
+			ticket = _ticket.load(std::memory_order_acquire);
+
+			if (_pending.load(std::memory_order_acquire) == 0)
+				break;
+
+			if ((fd = _pop()) < 0) {
+				_ticket.wait(ticket, std::memory_order_acquire);
+				continue;
+			}
+
+			// Once stopped, only close the queued directories so
+			// every thread sees the end of the walk.
+			if (_stop.load(std::memory_order_relaxed)) [[unlikely]]
+				::close(fd);
+			else
+				try {
+					_walk(fd);
+				} catch (...) {
+					_abort(std::current_exception());
+				}
+
+			if (_pending.fetch_sub(1, std::memory_order_acq_rel)
+			    == 1)
+				_notify();
+		}
+	}
+
+	void _spawned() noexcept
+	{
+		PthreadRegistry::enlist("dirwalker");
+		_work();
+	}
+
+ public:
+	explicit DirectoryWalker(Visitor visitor, size_t nthreads = 1)
+		: _visitor(std::move(visitor)), _nthreads(nthreads)
+		, _pending(0), _ticket(0), _error(0), _stop(false)
+	{
+		assert(nthreads > 0);
+	}
+
+	DirectoryWalker(const DirectoryWalker &other) = delete;
+	DirectoryWalker(DirectoryWalker &&other) = delete;
+
+	DirectoryWalker &operator=(const DirectoryWalker &other) = delete;
+	DirectoryWalker &operator=(DirectoryWalker &&other) = delete;
+
+
+	// Walk the tree rooted at `path`, relative to `dirfd`.
+	// Entries which cannot be inspected are skipped and the walk goes on.
+	// The calling thread takes part in the walk and returns once all the
+	// threads are done.
+	// The handler is then called with 0 on success or -1 with `errno`
+	// set to the first error met, unless the visitor threw, in which case
+	// its exception is rethrown instead.
+	//
+	template<typename ErrHandler>
+	auto walk(int dirfd, const char *path, ErrHandler &&handler)
+	{
+		std::vector<Worker> workers;
+		std::exception_ptr exception;
+		size_t i;
+		int fd;
+
+		assert(_pending.load() == 0);
+
+		if ((fd = ::openat(dirfd, path, OPEN_FLAGS)) < 0) [[unlikely]]
+			return handler(-1);
+
+		_error.store(0, std::memory_order_relaxed);
+		_stop.store(false, std::memory_order_relaxed);
+		_pending.store(1, std::memory_order_relaxed);
+		_queue.push_back(fd);
+
+		workers.resize(_nthreads - 1);
+
+		for (i = 0; i < workers.size(); i++)
+			if (workers[i].template
+			    create<&DirectoryWalker::_spawned>
+			    (this, [](int r) { return r; }) != 0) [[unlikely]]
+				break;
+
+		_work();
+
+		while (i-- > 0)
+			workers[i].join();
+
+		if (_exception != nullptr) [[unlikely]] {
+			exception = std::move(_exception);
+			_exception = nullptr;
+			std::rethrow_exception(exception);
+		}
+
+		if (_error.load() == 0)
+			return handler(0);
+
+		errno = _error.load();
+
+		return handler(-1);
+	}
+
+	template<typename ErrHandler>
+	auto walk(const char *path, ErrHandler &&handler)
+	{
+		return walk(AT_FDCWD, path, std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto walk(const std::string &path, ErrHandler &&handler)
+	{
+		return walk(AT_FDCWD, path.c_str(),
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename Path>
+	void walk(Path &&path)
+	{
+		walk(std::forward<Path>(path), [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwwalk();
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwwalk()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+
+		SystemException::throwErrno();
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,406 @@
+#ifndef _INCLUDE_METASYS_FS_FILE_HXX_
+#define _INCLUDE_METASYS_FS_FILE_HXX_
+
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <string>
+
+#include <metasys/io/ReadableDescriptor.hxx>
+#include <metasys/io/WritableDescriptor.hxx>
+#include <metasys/sys/ClosingDescriptor.hxx>
+#include <metasys/sys/SystemException.hxx>
+#include <metasys/sys/Trace.hxx>
+
+
+namespace metasys {
+
+
+namespace details {
+
+
+using FileBase =
+	WritableInterface
+	<ReadableInterface
+	 <ClosingDescriptor>>;
+
+
+}
+
+
+// Regular file opened with `openat()`.
+// Besides the sequential `read()` and `write()`, the positional `pread()`
+// and `pwrite()` do not move the file offset so several threads can share
+// the same `File` without seeking.
+//
+class File : public details::FileBase
+{
+ public:
+	using details::FileBase::FileBase;
+
+	static constexpr int OPEN_FLAGS = O_CLOEXEC;
+
+	static constexpr int DIRECT  = O_DIRECT;
+	static constexpr int NOATIME = O_NOATIME;
+	static constexpr int TMPFILE = O_TMPFILE;
+
+	static constexpr mode_t DEFAULT_MODE = 0666;
+
+
+	template<typename ErrHandler>
+	auto open(int dirfd, const char *path, int flags, mode_t mode,
+		  ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid() == false);
+
+		reset(::openat(dirfd, path, OPEN_FLAGS | flags, mode));
+
+		return handler(value());
+	}
+
+	template<typename ErrHandler>
+	auto open(const FileDescriptor &dir, const char *path, int flags,
+		  mode_t mode, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return open(dir.value(), path, flags, mode,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto open(const char *path, int flags, mode_t mode,
+		  ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return open(AT_FDCWD, path, flags, mode,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto open(const std::string &path, int flags, mode_t mode,
+		  ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return open(AT_FDCWD, path.c_str(), flags, mode,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	void open(int dirfd, const char *path, int flags,
+		  mode_t mode = DEFAULT_MODE)
+	{
+		open(dirfd, path, flags, mode, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwopen();
+		});
+	}
+
+	void open(const FileDescriptor &dir, const char *path, int flags,
+		  mode_t mode = DEFAULT_MODE)
+	{
+		open(dir.value(), path, flags, mode);
+	}
+
+	void open(const char *path, int flags, mode_t mode = DEFAULT_MODE)
+	{
+		open(AT_FDCWD, path, flags, mode);
+	}
+
+	void open(const std::string &path, int flags,
+		  mode_t mode = DEFAULT_MODE)
+	{
+		open(AT_FDCWD, path.c_str(), flags, mode);
+	}
+
+	template<typename ErrHandler>
+	static File openinit(int dirfd, const char *path, int flags,
+			     mode_t mode, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		int fd = ::openat(dirfd, path, OPEN_FLAGS | flags, mode);
+
+		handler(fd);
+
+		return File(fd);
+	}
+
+	template<typename ErrHandler>
+	static File openinit(const char *path, int flags, mode_t mode,
+			     ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return openinit(AT_FDCWD, path, flags, mode,
+				std::forward<ErrHandler>(handler));
+	}
+
+	static File openinit(int dirfd, const char *path, int flags,
+			     mode_t mode = DEFAULT_MODE)
+	{
+		return openinit(dirfd, path, flags, mode, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwopen();
+		});
+	}
+
+	static File openinit(const char *path, int flags,
+			     mode_t mode = DEFAULT_MODE)
+	{
+		return openinit(AT_FDCWD, path, flags, mode);
+	}
+
+	static File openinit(const std::string &path, int flags,
+			     mode_t mode = DEFAULT_MODE)
+	{
+		return openinit(AT_FDCWD, path.c_str(), flags, mode);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwopen()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+
+		SystemException::throwErrno();
+	}
+
+
+	template<typename ErrHandler>
+	auto pread(void *dest, size_t len, off_t offset, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+
+		return handler(traced<TracePoint::Pread>([&]() {
+			return ::pread(value(), dest, len, offset);
+		}));
+	}
+
+	size_t pread(void *dest, size_t len, off_t offset)
+	{
+		ssize_t ret;
+
+		assert(valid());
+
+	retry:
+		ret = traced<TracePoint::Pread>([&]() {
+			return ::pread(value(), dest, len, offset);
+		});
+
+		if (ret < 0) [[unlikely]] {
+			if (errno == EINTR)
+				goto retry;
+			throwpread();
+		}
+
+		return ((size_t) ret);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwpread()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+		assert(errno != EISDIR);
+		assert(errno != ESPIPE);
+
+		SystemException::throwErrno();
+	}
+
+
+	template<typename ErrHandler>
+	auto pwrite(const void *src, size_t len, off_t offset,
+		    ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+
+		return handler(traced<TracePoint::Pwrite>([&]() {
+			return ::pwrite(value(), src, len, offset);
+		}));
+	}
+
+	size_t pwrite(const void *src, size_t len, off_t offset)
+	{
+		ssize_t ret;
+
+		assert(valid());
+
+	retry:
+		ret = traced<TracePoint::Pwrite>([&]() {
+			return ::pwrite(value(), src, len, offset);
+		});
+
+		if (ret < 0) [[unlikely]] {
+			if (errno == EINTR)
+				goto retry;
+			throwpwrite();
+		}
+
+		return ((size_t) ret);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwpwrite()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+		assert(errno != ESPIPE);
+
+		SystemException::throwErrno();
+	}
+
+
+	// Reserve the disk space for `len` bytes from `offset` so that later
+	// writes in this range cannot fail with `ENOSPC`.
+	//
+	template<typename ErrHandler>
+	auto allocate(int mode, off_t offset, off_t len, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+
+		return handler(::fallocate(value(), mode, offset, len));
+	}
+
+	void allocate(int mode, off_t offset, off_t len)
+	{
+		allocate(mode, offset, len, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwallocate();
+		});
+	}
+
+	void allocate(off_t offset, off_t len)
+	{
+		allocate(0, offset, len);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwallocate()
+	{
+		assert(errno != EBADF);
+
+		SystemException::throwErrno();
+	}
+
+
+	// Unlike most system calls, `posix_fadvise()` returns the error code
+	// instead of setting `errno`. The handler still receives -1 with
+	// `errno` set for consistency.
+	//
+	template<typename ErrHandler>
+	auto advise(off_t offset, off_t len, int advice, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		int ret;
+
+		assert(valid());
+
+		if ((ret = ::posix_fadvise(value(), offset, len, advice)) != 0) {
+			errno = ret;
+			ret = -1;
+		}
+
+		return handler(ret);
+	}
+
+	void advise(off_t offset, off_t len, int advice)
+	{
+		advise(offset, len, advice, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwadvise();
+		});
+	}
+
+	void advise(int advice)
+	{
+		advise(0, 0, advice);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwadvise()
+	{
+		assert(errno != EBADF);
+
+		SystemException::throwErrno();
+	}
+
+
+	template<typename ErrHandler>
+	auto readahead(off_t offset, size_t len, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+
+		return handler(::readahead(value(), offset, len));
+	}
+
+	void readahead(off_t offset, size_t len)
+	{
+		readahead(offset, len, [](ssize_t ret) {
+			if (ret < 0) [[unlikely]]
+				throwreadahead();
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwreadahead()
+	{
+		assert(errno != EBADF);
+
+		SystemException::throwErrno();
+	}
+
+
+	template<typename ErrHandler>
+	auto datasync(ErrHandler &&handler) noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+
+		return handler(::fdatasync(value()));
+	}
+
+	void datasync()
+	{
+		datasync([](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwsync();
+		});
+	}
+
+	template<typename ErrHandler>
+	auto sync(ErrHandler &&handler) noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+
+		return handler(::fsync(value()));
+	}
+
+	void sync()
+	{
+		sync([](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwsync();
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwsync()
+	{
+		assert(errno != EBADF);
+
+		SystemException::throwErrno();
+	}
+};
+
+
+}
+
+
+#endif
@@ -251,6 +251,7 @@ class Stat : public stat
 		});
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void scanthrow()
 	{
 		assert(errno != EBADF);
@@ -0,0 +1,275 @@
+#ifndef _INCLUDE_METASYS_FS_STATX_HXX_
+#define _INCLUDE_METASYS_FS_STATX_HXX_
+
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+
+#include <metasys/sys/FileDescriptor.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+namespace metasys {
+
+
+// File status obtained with `statx()`.
+// Unlike `Stat`, only the fields in `Mask` are requested to the kernel,
+// which can spare expensive attribute fetches on network filesystems.
+// The accessors of the fields which are not in `Mask`, like `size()` or
+// `mtime()`, do not compile. The inherited `stx_*` members remain public as
+// in `struct statx`, and those not in `Mask` hold no meaningful value.
+// A filesystem may still not provide a requested field (e.g. the birth
+// time), `has()` tells which ones are actually filled.
+//
+template<unsigned int Mask = STATX_BASIC_STATS>
+class Statx : public statx
+{
+ public:
+	static constexpr unsigned int MASK = Mask;
+
+
+	constexpr Statx() noexcept = default;
+
+	explicit constexpr Statx(const struct statx &buf) noexcept
+		: statx(buf)
+	{
+	}
+
+	template<typename ErrHandler>
+	Statx(int fd, const char *path, int flags, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		scan(fd, path, flags, std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	Statx(const FileDescriptor &fd, const char *path, int flags,
+	      ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+		: Statx(fd.value(), path, flags,
+			std::forward<ErrHandler>(handler))
+	{
+	}
+
+	template<typename ErrHandler>
+	Statx(int fd, const std::string &path, int flags,
+	      ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+		: Statx(fd, path.c_str(), flags,
+			std::forward<ErrHandler>(handler))
+	{
+	}
+
+	template<typename ErrHandler>
+	Statx(const FileDescriptor &fd, const std::string &path, int flags,
+	      ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+		: Statx(fd.value(), path.c_str(), flags,
+			std::forward<ErrHandler>(handler))
+	{
+	}
+
+	template<typename Fd, typename Path>
+	Statx(Fd &&fd, Path &&path, int flags)
+		: Statx(std::forward<Fd>(fd), std::forward<Path>(path),
+			flags, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				scanthrow();
+		})
+	{
+	}
+
+	template<typename Target, typename ErrHandler>
+	Statx(Target &&target, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		scan(std::forward<Target>(target),
+		     std::forward<ErrHandler>(handler));
+	}
+
+	template<typename Target>
+	explicit Statx(Target &&target)
+		: Statx(std::forward<Target>(target), [](int ret) {
+			if (ret < 0) [[unlikely]]
+				scanthrow();
+		})
+	{
+	}
+
+	constexpr Statx(const Statx &other) noexcept = default;
+	Statx(Statx &&other) noexcept = default;
+
+	Statx &operator=(const Statx &other) noexcept = default;
+
+
+	struct statx &value() noexcept
+	{
+		return *this;
+	}
+
+	const struct statx &value() const noexcept
+	{
+		return *this;
+	}
+
+
+	static constexpr int EMPTY_PATH       = AT_EMPTY_PATH;
+	static constexpr int NO_AUTOMOUNT     = AT_NO_AUTOMOUNT;
+	static constexpr int SYMLINK_NOFOLLOW = AT_SYMLINK_NOFOLLOW;
+	static constexpr int DONT_SYNC        = AT_STATX_DONT_SYNC;
+	static constexpr int FORCE_SYNC       = AT_STATX_FORCE_SYNC;
+
+
+	template<typename ErrHandler>
+	auto scan(int fd, const char *path, int flags, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return handler(::statx(fd, path, flags, Mask, this));
+	}
+
+	template<typename ErrHandler>
+	auto scan(const FileDescriptor &fd, const char *path, int flags,
+		  ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return scan(fd.value(), path, flags,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto scan(int fd, const std::string &path, int flags,
+		  ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return scan(fd, path.c_str(), flags,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto scan(const FileDescriptor &fd, const std::string &path, int flags,
+		  ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return scan(fd.value(), path.c_str(), flags,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename Fd, typename Path>
+	void scan(Fd &&fd, Path &&path, int flags)
+	{
+		scan(std::forward<Fd>(fd), std::forward<Path>(path), flags,
+		     [](int ret) {
+			     if (ret < 0) [[unlikely]]
+				     scanthrow();
+		     });
+	}
+
+
+	template<typename ErrHandler>
+	auto scan(const char *path, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return scan(AT_FDCWD, path, 0,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto scan(const std::string &path, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return scan(path.c_str(), std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto scan(int fd, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return scan(fd, "", AT_EMPTY_PATH,
+			    std::forward<ErrHandler>(handler));
+	}
+
+	template<typename ErrHandler>
+	auto scan(const FileDescriptor &fd, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return scan(fd.value(), std::forward<ErrHandler>(handler));
+	}
+
+	template<typename Target>
+	void scan(Target &&target)
+	{
+		scan(std::forward<Target>(target), [](int ret) {
+			if (ret < 0) [[unlikely]]
+				scanthrow();
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void scanthrow()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+		assert(errno != EINVAL);
+		assert(errno != ENAMETOOLONG);
+
+		SystemException::throwErrno();
+	}
+
+
+	// Indicate if all the fields in `mask` have been filled by the last
+	// successful scan.
+	//
+	constexpr bool has(unsigned int mask) const noexcept
+	{
+		return ((stx_mask & mask) == mask);
+	}
+
+	constexpr mode_t mode() const noexcept
+		requires ((Mask & (STATX_TYPE | STATX_MODE)) != 0)
+	{
+		return stx_mode;
+	}
+
+	constexpr uint64_t size() const noexcept
+		requires ((Mask & STATX_SIZE) != 0)
+	{
+		return stx_size;
+	}
+
+	constexpr const struct statx_timestamp &atime() const noexcept
+		requires ((Mask & STATX_ATIME) != 0)
+	{
+		return stx_atime;
+	}
+
+	constexpr const struct statx_timestamp &mtime() const noexcept
+		requires ((Mask & STATX_MTIME) != 0)
+	{
+		return stx_mtime;
+	}
+
+	constexpr const struct statx_timestamp &ctime() const noexcept
+		requires ((Mask & STATX_CTIME) != 0)
+	{
+		return stx_ctime;
+	}
+
+	constexpr const struct statx_timestamp &btime() const noexcept
+		requires ((Mask & STATX_BTIME) != 0)
+	{
+		return stx_btime;
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef _INCLUDE_METASYS_IO_BUFFERPOOL_HXX_
+#define _INCLUDE_METASYS_IO_BUFFERPOOL_HXX_
+
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <metasys/sys/MemoryMapping.hxx>
+
+
+namespace metasys {
+
+
+// Pool of equally sized buffers shared by several threads.
+// The free buffers are kept in a lock-free stack, and each thread should
+// go through its own `BufferPool::Cache` which only touches the shared
+// stack to refill or spill a batch of buffers.
+// The buffers live in one anonymous mapping: a buffer which has never been
+// used does not consume any memory.
+//
+class BufferPool
+{
+	static constexpr uint32_t NONE = UINT32_MAX;
+
+
+	MemoryMapping                             _mapping;
+	size_t                                    _bufsize;
+	uint32_t                                  _count;
+	std::unique_ptr<std::atomic<uint32_t>[]>  _next;
+
+	// Top of the free stack as (tag << 32) | index.
+	alignas(64) std::atomic<uint64_t>         _head;
+
+
+	void *_buffer(uint32_t index) const noexcept
+	{
+		return (static_cast<uint8_t *> (_mapping.data()) +
+			index * _bufsize);
+	}
+
+	uint32_t _index(const void *buf) const noexcept
+	{
+		size_t off = static_cast<const uint8_t *> (buf) -
+			static_cast<const uint8_t *> (_mapping.data());
+
+		assert((off % _bufsize) == 0);
+		assert((off / _bufsize) < _count);
+
+		return static_cast<uint32_t> (off / _bufsize);
+	}
+
+
+ public:
+	BufferPool(size_t bufsize, uint32_t count);
+
+	BufferPool(const BufferPool &other) = delete;
+	BufferPool &operator=(const BufferPool &other) = delete;
+
+
+	size_t bufsize() const noexcept
+	{
+		return _bufsize;
+	}
+
+	uint32_t count() const noexcept
+	{
+		return _count;
+	}
+
+	// Take a buffer from the shared stack or return `nullptr` if there is
+	// none left.
+	//
+	void *acquire() noexcept;
+
+	// Give back a buffer to the shared stack.
+	//
+	void release(void *buf) noexcept;
+
+
+	// Per-thread stack of buffers in front of a `BufferPool`.
+	// A cache must only be used by one thread at a time and gives back
+	// all its buffers to the pool on destruction.
+	//
+	class Cache
+	{
+		BufferPool           &_pool;
+		std::vector<void *>   _free;
+		size_t                _capacity;
+
+
+	 public:
+		explicit Cache(BufferPool &pool, size_t capacity = 32);
+
+		Cache(const Cache &other) = delete;
+
+		~Cache();
+
+		Cache &operator=(const Cache &other) = delete;
+
+
+		BufferPool &pool() const noexcept
+		{
+			return _pool;
+		}
+
+		size_t size() const noexcept
+		{
+			return _free.size();
+		}
+
+		void *acquire() noexcept
+		{
+			void *ret;
+
+			if (_free.empty()) [[unlikely]]
+				refill();
+
+			if (_free.empty()) [[unlikely]]
+				return nullptr;
+
+			ret = _free.back();
+			_free.pop_back();
+
+			return ret;
+		}
+
+		void release(void *buf) noexcept
+		{
+			if (_free.size() == _capacity) [[unlikely]]
+				spill();
+
+			_free.push_back(buf);
+		}
+
+		// Move half the capacity from the pool to the cache.
+		//
+		void refill() noexcept;
+
+		// Move half the capacity from the cache to the pool.
+		//
+		void spill() noexcept;
+	};
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef _INCLUDE_METASYS_IO_BUFFEREDREADER_HXX_
+#define _INCLUDE_METASYS_IO_BUFFEREDREADER_HXX_
+
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <metasys/io/DelimiterScanner.hxx>
+#include <metasys/io/InputStream.hxx>
+
+
+namespace metasys {
+
+
+// Input stream reading from `Stream` by blocks of up to `N` bytes.
+// The `Stream` is held by value: use a reference type such as
+// `BufferedReader<TcpSocket &>` to wrap a stream without owning it.
+// The buffer is part of the object, there is no heap allocation.
+//
+template<typename Stream, size_t N = 4096>
+requires BatchInputStream<std::remove_reference_t<Stream>>
+class BufferedReader
+{
+	static_assert (N > 0);
+
+
+	Stream   _stream;
+	size_t   _head;
+	size_t   _tail;
+	uint8_t  _buf[N];
+
+
+	// Move the pending bytes at the beginning of the buffer.
+	//
+	void _compact() noexcept
+	{
+		if (_head == 0)
+			return;
+
+		std::memmove(_buf, _buf + _head, _tail - _head);
+		_tail -= _head;
+		_head = 0;
+	}
+
+
+ public:
+	template<typename ... Args>
+	explicit BufferedReader(Args && ... args)
+		: _stream(std::forward<Args>(args) ...), _head(0), _tail(0)
+	{
+	}
+
+	BufferedReader(const BufferedReader &other) = delete;
+	BufferedReader &operator=(const BufferedReader &other) = delete;
+
+
+	Stream &stream() noexcept
+	{
+		return _stream;
+	}
+
+	static constexpr size_t capacity() noexcept
+	{
+		return N;
+	}
+
+	// Number of bytes which can be read without calling the stream.
+	//
+	size_t available() const noexcept
+	{
+		return (_tail - _head);
+	}
+
+	// Read once from the stream to append as many bytes as possible in
+	// the buffer. Return the number of bytes appended, 0 meaning either
+	// the end of the stream or a full buffer.
+	//
+	size_t fill()
+	{
+		size_t ret;
+
+		_compact();
+
+		if (_tail == N)
+			return 0;
+
+		ret = _stream.read(_buf + _tail, N - _tail);
+		_tail += ret;
+
+		return ret;
+	}
+
+
+	// Return the next byte or -1 at the end of the stream.
+	//
+	int16_t read()
+	{
+		if (_head == _tail) [[unlikely]] {
+			if (fill() == 0)
+				return -1;
+		}
+
+		return _buf[_head++];
+	}
+
+	int16_t peek()
+	{
+		if (_head == _tail) [[unlikely]] {
+			if (fill() == 0)
+				return -1;
+		}
+
+		return _buf[_head];
+	}
+
+	// Read up to `len` bytes with at most one call to the stream.
+	// Requests larger than the buffer bypass it once it is empty.
+	//
+	size_t read(void *dest, size_t len)
+	{
+		size_t n;
+
+		if (_head == _tail) {
+			if (len >= N)
+				return _stream.read(dest, len);
+			if (fill() == 0)
+				return 0;
+		}
+
+		n = available();
+		if (n > len)
+			n = len;
+
+		std::memcpy(dest, _buf + _head, n);
+		_head += n;
+
+		return n;
+	}
+
+
+	// Return a view on the next bytes up to and including the first byte
+	// of `delims`.
+	// The view is valid until the next call on this reader.
+	// If no delimiter is found in a full buffer, or at the end of the
+	// stream, the view covers all the pending bytes and does not end
+	// with a delimiter. An empty view indicates the end of the stream.
+	//
+	std::string_view readuntil(const DelimiterScanner &delims)
+	{
+		const uint8_t *start;
+		size_t scanned = 0;
+		size_t len;
+
+		while (true) {
+			start = _buf + _head;
+			len = scanned + delims.find(start + scanned,
+						    available() - scanned);
+
+			if (len < available()) {
+				len += 1;
+				break;
+			}
+
+			scanned = available();
+
+			if ((scanned == N) || (fill() == 0)) {
+				len = available();
+				break;
+			}
+		}
+
+		_head += len;
+
+		return std::string_view(reinterpret_cast<const char *> (start),
+					len);
+	}
+
+	// Return a view on the next line without its "\n" or "\r\n"
+	// terminator, with the same validity and partial line rules as
+	// `readuntil()`.
+	//
+	std::string_view readline()
+	{
+		std::string_view ret = readuntil('\n');
+
+		if (ret.ends_with('\n')) {
+			ret.remove_suffix(1);
+			if (ret.ends_with('\r'))
+				ret.remove_suffix(1);
+		}
+
+		return ret;
+	}
+
+	// Copy the next bytes up to and including the first byte of `delims`
+	// in `dest`, stopping after `len` bytes or at the end of the stream.
+	//
+	size_t readuntil(const DelimiterScanner &delims, void *dest,
+			 size_t len)
+	{
+		uint8_t *ptr = static_cast<uint8_t *> (dest);
+		size_t n, pos, done = 0;
+		bool found;
+
+		while (done < len) {
+			if ((_head == _tail) && (fill() == 0))
+				break;
+
+			n = available();
+			if (n > (len - done))
+				n = len - done;
+
+			pos = delims.find(_buf + _head, n);
+
+			found = (pos < n);
+
+			if (found)
+				n = pos + 1;
+
+			std::memcpy(ptr + done, _buf + _head, n);
+			_head += n;
+			done += n;
+
+			if (found)
+				break;
+		}
+
+		return done;
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef _INCLUDE_METASYS_IO_BUFFEREDWRITER_HXX_
+#define _INCLUDE_METASYS_IO_BUFFEREDWRITER_HXX_
+
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include <metasys/io/OutputStream.hxx>
+
+
+namespace metasys {
+
+
+// Output stream accumulating the written bytes in a buffer of `N` bytes and
+// writing them to `Stream` only when the buffer is full or on `flush()`.
+// The `Stream` is held by value: use a reference type such as
+// `BufferedWriter<TcpSocket &>` to wrap a stream without owning it.
+// The destructor flushes the pending bytes but ignores any error, call
+// `flush()` explicitly to get them.
+//
+template<typename Stream, size_t N = 4096>
+requires BatchOutputStream<std::remove_reference_t<Stream>>
+class BufferedWriter
+{
+	static_assert (N > 0);
+
+
+	Stream   _stream;
+	size_t   _len;
+	uint8_t  _buf[N];
+
+
+	void _writeall(const uint8_t *src, size_t len)
+	{
+		size_t done = 0;
+
+		while (done < len)
+			done += _stream.write(src + done, len - done);
+	}
+
+
+ public:
+	template<typename ... Args>
+	explicit BufferedWriter(Args && ... args)
+		: _stream(std::forward<Args>(args) ...), _len(0)
+	{
+	}
+
+	BufferedWriter(const BufferedWriter &other) = delete;
+
+	~BufferedWriter()
+	{
+		if (_len == 0)
+			return;
+
+#ifdef __cpp_exceptions
+		try {
+			flush();
+		} catch (...) {
+		}
+#else
+		flush();
+#endif
+	}
+
+	BufferedWriter &operator=(const BufferedWriter &other) = delete;
+
+
+	Stream &stream() noexcept
+	{
+		return _stream;
+	}
+
+	static constexpr size_t capacity() noexcept
+	{
+		return N;
+	}
+
+	// Number of bytes written but not flushed yet.
+	//
+	size_t pending() const noexcept
+	{
+		return _len;
+	}
+
+
+	void write(int8_t c)
+	{
+		if (_len == N) [[unlikely]]
+			flush();
+
+		_buf[_len++] = static_cast<uint8_t> (c);
+	}
+
+	// Append `len` bytes to the buffer.
+	// Writes larger than the buffer go directly to the stream after the
+	// pending bytes are flushed.
+	//
+	size_t write(const void *src, size_t len)
+	{
+		if (len > (N - _len)) {
+			flush();
+
+			if (len >= N) {
+				_writeall(static_cast<const uint8_t *> (src),
+					  len);
+				return len;
+			}
+		}
+
+		std::memcpy(_buf + _len, src, len);
+		_len += len;
+
+		return len;
+	}
+
+	// Write all the pending bytes to the stream.
+	//
+	void flush()
+	{
+		size_t len = _len;
+
+		// Forget the pending bytes first: if the stream throws, the
+		// destructor must not try to write them again.
+		_len = 0;
+
+		_writeall(_buf, len);
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef _INCLUDE_METASYS_IO_DELIMITERSCANNER_HXX_
+#define _INCLUDE_METASYS_IO_DELIMITERSCANNER_HXX_
+
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+namespace metasys {
+
+
+// Finder of the first occurrence of any byte of a set in a buffer.
+// Sets of up to `SIMD_MAX` bytes are scanned with SSE2 or AVX2, selected
+// once at startup from CPUID, larger sets fall back on a bitmap lookup.
+// Single byte sets use `memchr()` which the libc already dispatches.
+//
+class DelimiterScanner
+{
+ public:
+	enum class Isa
+	{
+		Scalar,
+		Sse2,
+		Avx2
+	};
+
+	static constexpr size_t SIMD_MAX = 8;
+
+
+ private:
+	uint64_t  _bitmap[4];
+	uint8_t   _bytes[SIMD_MAX];
+	size_t    _count;
+
+
+ public:
+	constexpr DelimiterScanner(std::string_view delims) noexcept
+		: _bitmap{0, 0, 0, 0}, _bytes{}, _count(0)
+	{
+		uint8_t c;
+
+		assert(delims.empty() == false);
+
+		for (char d : delims) {
+			c = static_cast<uint8_t> (d);
+
+			if (contains(c))
+				continue;
+
+			_bitmap[c >> 6] |= (uint64_t(1) << (c & 63));
+
+			if (_count < SIMD_MAX)
+				_bytes[_count] = c;
+			_count += 1;
+		}
+	}
+
+	constexpr DelimiterScanner(const char *delims) noexcept
+		: DelimiterScanner(std::string_view(delims))
+	{
+	}
+
+	constexpr DelimiterScanner(uint8_t delim) noexcept
+		: _bitmap{0, 0, 0, 0}, _bytes{delim}, _count(1)
+	{
+		_bitmap[delim >> 6] |= (uint64_t(1) << (delim & 63));
+	}
+
+	constexpr bool contains(uint8_t c) const noexcept
+	{
+		return ((_bitmap[c >> 6] >> (c & 63)) & 1);
+	}
+
+	constexpr size_t size() const noexcept
+	{
+		return _count;
+	}
+
+
+	// Return the offset of the first delimiter in `buf` or `len` if there
+	// is none.
+	//
+	size_t find(const void *buf, size_t len) const noexcept;
+
+	// Same as above with an explicit instruction set, which must be
+	// supported by the running CPU.
+	//
+	size_t find(const void *buf, size_t len, Isa isa) const noexcept;
+
+	// Best instruction set of the running CPU.
+	//
+	static Isa isa() noexcept;
+};
+
+
+}
+
+
+#endif
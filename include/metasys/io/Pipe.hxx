@@ -270,6 +270,7 @@ class Pipe
 		return ret;
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwopen()
 	{
 		assert(errno != EFAULT);
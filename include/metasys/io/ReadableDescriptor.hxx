@@ -11,6 +11,7 @@
 #include <metasys/io/InputStream.hxx>
 #include <metasys/sys/FileDescriptor.hxx>
 #include <metasys/sys/SystemException.hxx>
+#include <metasys/sys/Trace.hxx>
 
 
 namespace metasys {
@@ -34,7 +35,9 @@ class ReadableInterface : public Descriptor
 	{
 		assert(Descriptor::valid());
 
-		return handler(::read(Descriptor::_fd, dest, len));
+		return handler(traced<TracePoint::Read>([&]() {
+			return ::read(Descriptor::_fd, dest, len);
+		}));
 	}
 
 	size_t read(void *dest, size_t len)
@@ -44,7 +47,11 @@ class ReadableInterface : public Descriptor
 		assert(Descriptor::valid());
 
 	retry:
-		if ((ret = ::read(Descriptor::_fd, dest, len))<0)[[unlikely]] {
+		ret = traced<TracePoint::Read>([&]() {
+			return ::read(Descriptor::_fd, dest, len);
+		});
+
+		if (ret < 0) [[unlikely]] {
 			if ((errno == EAGAIN) || (errno == EINTR))
 				goto retry;
 			throwread();
@@ -53,6 +60,7 @@ class ReadableInterface : public Descriptor
 		return ((size_t) ret);
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwread()
 	{
 		assert(errno != EBADF);
@@ -0,0 +1,144 @@
+#ifndef _INCLUDE_METASYS_IO_RECEIVEBUFFER_HXX_
+#define _INCLUDE_METASYS_IO_RECEIVEBUFFER_HXX_
+
+
+#include <sys/types.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include <metasys/io/BufferPool.hxx>
+
+
+namespace metasys {
+
+
+// Receive buffer of a connection which only holds a pooled buffer while it
+// has pending data.
+// Call `receive()` when the descriptor is reported readable, for instance
+// by an `EpollDescriptor`, and `consume()` once the data is processed: the
+// buffer goes back to the cache as soon as it is drained, so an idle
+// connection costs the size of this object.
+// The descriptor should be non-blocking.
+//
+class ReceiveBuffer
+{
+	BufferPool::Cache  *_cache;
+	uint8_t            *_buf;
+	uint32_t            _head;
+	uint32_t            _tail;
+
+
+	void _drop() noexcept
+	{
+		_cache->release(_buf);
+		_buf = nullptr;
+		_head = 0;
+		_tail = 0;
+	}
+
+
+ public:
+	explicit ReceiveBuffer(BufferPool::Cache &cache) noexcept
+		: _cache(&cache), _buf(nullptr), _head(0), _tail(0)
+	{
+	}
+
+	ReceiveBuffer(const ReceiveBuffer &other) = delete;
+
+	ReceiveBuffer(ReceiveBuffer &&other) noexcept
+		: _cache(other._cache), _buf(other._buf), _head(other._head)
+		, _tail(other._tail)
+	{
+		other._buf = nullptr;
+		other._head = 0;
+		other._tail = 0;
+	}
+
+	~ReceiveBuffer()
+	{
+		if (_buf != nullptr)
+			_drop();
+	}
+
+	ReceiveBuffer &operator=(const ReceiveBuffer &other) = delete;
+
+
+	bool holding() const noexcept
+	{
+		return (_buf != nullptr);
+	}
+
+	std::span<const uint8_t> data() const noexcept
+	{
+		return std::span<const uint8_t>(_buf + _head, _tail - _head);
+	}
+
+	// Mark the first `len` bytes of `data()` as processed.
+	//
+	void consume(size_t len) noexcept
+	{
+		assert(len <= (_tail - _head));
+
+		// Without a buffer there is nothing to consume, but
+		// `consume(data().size())` is still valid.
+		if (len == 0)
+			return;
+
+		_head += len;
+
+		if (_head == _tail)
+			_drop();
+	}
+
+
+	// Read once from `stream` at the end of the pending data.
+	// The handler receives the number of bytes read, 0 at the end of the
+	// stream or if the buffer is full, and -1 on error including
+	// `EAGAIN`. A buffer is only taken from the cache for the time there
+	// is data in it.
+	// There is no throwing variant since `EAGAIN` is the expected way
+	// for a non-blocking receive to end.
+	//
+	template<typename Stream, typename ErrHandler>
+	auto receive(Stream &stream, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		size_t bufsize = _cache->pool().bufsize();
+		ssize_t ret;
+
+		if (_buf == nullptr) {
+			_buf = static_cast<uint8_t *> (_cache->acquire());
+
+			if (_buf == nullptr) [[unlikely]] {
+				errno = ENOBUFS;
+				return handler(-1);
+			}
+		} else if ((_head > 0) && (_tail == bufsize)) {
+			std::memmove(_buf, _buf + _head, _tail - _head);
+			_tail -= _head;
+			_head = 0;
+		}
+
+		ret = stream.read(_buf + _tail, bufsize - _tail,
+				  [](ssize_t r) { return r; });
+
+		if (ret > 0)
+			_tail += static_cast<uint32_t> (ret);
+
+		if (_head == _tail)
+			_drop();
+
+		return handler(ret);
+	}
+};
+
+
+}
+
+
+#endif
@@ -11,6 +11,7 @@
 #include <metasys/io/OutputStream.hxx>
 #include <metasys/sys/FileDescriptor.hxx>
 #include <metasys/sys/SystemException.hxx>
+#include <metasys/sys/Trace.hxx>
 
 
 namespace metasys {
@@ -35,7 +36,9 @@ class WritableInterface : public Descriptor
 	{
 		assert(Descriptor::valid());
 
-		return handler(::write(Descriptor::_fd, src, len));
+		return handler(traced<TracePoint::Write>([&]() {
+			return ::write(Descriptor::_fd, src, len);
+		}));
 	}
 
 	[[gnu::always_inline]]
@@ -46,7 +49,9 @@ class WritableInterface : public Descriptor
 		assert(Descriptor::valid());
 
 	retry:
-		ret = ::write(Descriptor::_fd, src, len);
+		ret = traced<TracePoint::Write>([&]() {
+			return ::write(Descriptor::_fd, src, len);
+		});
 		if (ret <= 0) [[unlikely]] {
 			if ((errno == EAGAIN) || (errno == EINTR))
 				goto retry;
@@ -56,6 +61,7 @@ class WritableInterface : public Descriptor
 		return ((size_t) ret);
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwwrite()
 	{
 		assert(errno != EBADF);
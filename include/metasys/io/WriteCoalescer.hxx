@@ -0,0 +1,265 @@
+#ifndef _INCLUDE_METASYS_IO_WRITECOALESCER_HXX_
+#define _INCLUDE_METASYS_IO_WRITECOALESCER_HXX_
+
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include <metasys/io/OutputStream.hxx>
+#include <metasys/sys/SystemException.hxx>
+#include <metasys/sys/Trace.hxx>
+
+
+namespace metasys {
+
+
+// Output stream gathering the writes to `Descriptor` and sending them with
+// a single `writev()` on `flush()`.
+// Small writes are copied in an internal buffer of `N` bytes while large
+// ones are referenced in place and sent right away along with the pending
+// bytes, so they are never copied.
+// With `writeref()`, the caller can also defer the sending of a buffer it
+// keeps alive until the next flush.
+// The `Descriptor` is held by value: use a reference type such as
+// `WriteCoalescer<TcpSocket &>` to wrap a descriptor without owning it.
+//
+template<typename Descriptor, size_t N = 4096, size_t IOVMAX = 64>
+class WriteCoalescer
+{
+	static_assert (N > 0);
+	static_assert ((IOVMAX > 1) && (IOVMAX <= IOV_MAX));
+
+
+	Descriptor    _fd;
+	int           _flags;
+	size_t        _len;
+	size_t        _iovhead;
+	size_t        _iovcnt;
+	struct iovec  _iov[IOVMAX];
+	uint8_t       _buf[N];
+
+
+	void _push(const void *src, size_t len) noexcept
+	{
+		assert(_iovcnt < IOVMAX);
+
+		_iov[_iovcnt].iov_base = const_cast<void *> (src);
+		_iov[_iovcnt].iov_len = len;
+		_iovcnt += 1;
+	}
+
+	void _copy(const void *src, size_t len) noexcept
+	{
+		uint8_t *dest = _buf + _len;
+		struct iovec *last;
+
+		assert(len <= (N - _len));
+
+		std::memcpy(dest, src, len);
+		_len += len;
+
+		if (_iovcnt > _iovhead) {
+			last = &_iov[_iovcnt - 1];
+
+			if ((static_cast<uint8_t *> (last->iov_base) +
+			     last->iov_len) == dest) {
+				last->iov_len += len;
+				return;
+			}
+		}
+
+		_push(dest, len);
+	}
+
+	ssize_t _send(int flags) noexcept
+	{
+		struct msghdr msg;
+
+		if (flags == 0) {
+			return traced<TracePoint::Writev>([&]() {
+				return ::writev(_fd.value(), _iov + _iovhead,
+						_iovcnt - _iovhead);
+			});
+		}
+
+		std::memset(&msg, 0, sizeof (msg));
+		msg.msg_iov = _iov + _iovhead;
+		msg.msg_iovlen = _iovcnt - _iovhead;
+
+		return traced<TracePoint::Writev>([&]() {
+			return ::sendmsg(_fd.value(), &msg, flags);
+		});
+	}
+
+	void _reset() noexcept
+	{
+		_iovhead = 0;
+		_iovcnt = 0;
+		_len = 0;
+	}
+
+	// Skip the first `done` bytes of the pending vector.
+	//
+	void _advance(size_t done) noexcept
+	{
+		while ((_iovhead < _iovcnt) && (done >= _iov[_iovhead].iov_len))
+			done -= _iov[_iovhead++].iov_len;
+
+		if (_iovhead == _iovcnt) {
+			_reset();
+			return;
+		}
+
+		_iov[_iovhead].iov_base =
+			static_cast<uint8_t *> (_iov[_iovhead].iov_base) + done;
+		_iov[_iovhead].iov_len -= done;
+	}
+
+	void _flushall(int flags)
+	{
+		ssize_t ret;
+
+		while (_iovcnt > 0) {
+			ret = _send(flags);
+
+			if (ret < 0) [[unlikely]] {
+				if ((errno == EAGAIN) || (errno == EINTR))
+					continue;
+
+				// Do not keep references to the buffers of
+				// the caller past the exception.
+				_reset();
+				throwflush();
+			}
+
+			_advance(static_cast<size_t> (ret));
+		}
+	}
+
+
+ public:
+	template<typename ... Args>
+	explicit WriteCoalescer(Args && ... args)
+		: _fd(std::forward<Args>(args) ...), _flags(0), _len(0)
+		, _iovhead(0), _iovcnt(0)
+	{
+	}
+
+	WriteCoalescer(const WriteCoalescer &other) = delete;
+
+	// Send the pending bytes, giving up silently on error.
+	// Call `flush()` beforehand to know whether they were all sent.
+	//
+	~WriteCoalescer()
+	{
+		flush([](int) {});
+	}
+
+	WriteCoalescer &operator=(const WriteCoalescer &other) = delete;
+
+
+	Descriptor &descriptor() noexcept
+	{
+		return _fd;
+	}
+
+	size_t pending() const noexcept
+	{
+		size_t i, ret = 0;
+
+		for (i = _iovhead; i < _iovcnt; i++)
+			ret += _iov[i].iov_len;
+
+		return ret;
+	}
+
+	// Send with `MSG_MORE` the flushes triggered by a full buffer, so
+	// the kernel waits for the rest of the message instead of sending a
+	// partial segment. Only valid for sockets.
+	// Explicit calls to `flush()` still push the data on the wire.
+	//
+	void setmore(bool more) noexcept
+	{
+		_flags = more ? MSG_MORE : 0;
+	}
+
+
+	size_t write(const void *src, size_t len)
+	{
+		if (len > (N / 4)) {
+			if (_iovcnt == IOVMAX)
+				_flushall(_flags);
+
+			_push(src, len);
+			_flushall(_flags);
+
+			return len;
+		}
+
+		if ((len > (N - _len)) || (_iovcnt == IOVMAX))
+			_flushall(_flags);
+
+		_copy(src, len);
+
+		return len;
+	}
+
+	// Queue `len` bytes at `src` without copying them.
+	// The caller must keep them unchanged until the next flush, which
+	// may be the one of the destructor.
+	//
+	void writeref(const void *src, size_t len)
+	{
+		if (_iovcnt == IOVMAX)
+			_flushall(_flags);
+
+		_push(src, len);
+	}
+
+
+	template<typename ErrHandler>
+	auto flush(ErrHandler &&handler) noexcept (noexcept (handler(-1)))
+	{
+		ssize_t ret;
+
+		while (_iovcnt > 0) {
+			if ((ret = _send(0)) < 0) [[unlikely]]
+				return handler(-1);
+
+			_advance(static_cast<size_t> (ret));
+		}
+
+		return handler(0);
+	}
+
+	void flush()
+	{
+		_flushall(0);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwflush()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
+};
+
+
+}
+
+
+#endif
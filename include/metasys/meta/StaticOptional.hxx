@@ -44,6 +44,16 @@ class StaticOptional<true, T>
 		return true;
 	}
 
+	T &value() noexcept
+	{
+		return _value;
+	}
+
+	const T &value() const noexcept
+	{
+		return _value;
+	}
+
 	template<typename Function, typename ... Args>
 	requires std::invocable<Function, T, Args ...>
 	void invoke(Function &&func, Args && ... args)
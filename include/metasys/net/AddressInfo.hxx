@@ -27,6 +27,9 @@
 
 #include <cassert>
 #include <cstddef>
+#include <type_traits>
+
+#include <metasys/sys/Result.hxx>
 
 
 namespace metasys {
@@ -153,6 +156,15 @@ class AddressInfo
 		     const struct addrinfo *hints, ErrHandler &&handler)
 		noexcept (noexcept (handler(-1)))
 	{
+		// The handler gets an `EAI_*` code, with `errno` only set for
+		// `EAI_SYSTEM`.
+		static_assert (!std::is_same_v<std::decay_t<ErrHandler>,
+			       detail::AsResult>,
+			       "getaddrinfo() does not report errors in errno");
+		static_assert (!std::is_same_v<std::decay_t<ErrHandler>,
+			       detail::AsCodeResult>,
+			       "getaddrinfo() does not return errno values");
+
 		assert(valid() == false);
 
 		return handler(::getaddrinfo(node, service, hints, &_ais));
@@ -161,6 +173,7 @@ class AddressInfo
 	void resolve(const char *node, const char *service,
 		     const struct addrinfo *hints);
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void resolvethrow(int ret);
 };
 
@@ -0,0 +1,250 @@
+#ifndef _INCLUDE_METASYS_NET_FRAMEREADER_HXX_
+#define _INCLUDE_METASYS_NET_FRAMEREADER_HXX_
+
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <metasys/net/bit.hxx>
+#include <metasys/sys/SystemException.hxx>
+#include <metasys/sys/Trace.hxx>
+
+
+namespace metasys {
+
+
+template<typename T>
+concept FrameLength = std::same_as<T, uint16_t>
+		   || std::same_as<T, uint32_t>
+		   || std::same_as<T, uint64_t>;
+
+
+// Reader of messages prefixed by their length as a big-endian `Length`
+// over a stream socket.
+// The bytes are received in a ring buffer of `N` bytes, filled by a single
+// `readv()` whatever the position of the free space, so one system call
+// usually brings in several frames.
+// A frame is handed out as a view into the ring when it is contiguous and
+// only copied when it wraps around the end of the ring.
+// Frames larger than `N - sizeof (Length)` bytes are rejected.
+// The `Descriptor` is held by value: use a reference type such as
+// `FrameReader<TcpSocket &>` to wrap a descriptor without owning it.
+//
+template<typename Descriptor, FrameLength Length = uint32_t,
+	 size_t N = 65536>
+class FrameReader
+{
+	static_assert ((N & (N - 1)) == 0);
+	static_assert (N > sizeof (Length));
+
+
+ public:
+	static constexpr size_t HEADER_SIZE = sizeof (Length);
+	static constexpr size_t MAX_FRAME   = N - HEADER_SIZE;
+
+
+ private:
+	Descriptor            _fd;
+	size_t                _head;
+	size_t                _tail;
+	std::vector<uint8_t>  _scratch;
+	uint8_t               _buf[N];
+
+
+	// Copy `len` bytes at offset `from` of the ring in `dest`.
+	//
+	void _copy(size_t from, void *dest, size_t len) const noexcept
+	{
+		size_t pos = from % N;
+		size_t first = std::min(len, N - pos);
+
+		std::memcpy(dest, _buf + pos, first);
+		std::memcpy(static_cast<uint8_t *> (dest) + first, _buf,
+			    len - first);
+	}
+
+
+ public:
+	template<typename ... Args>
+	explicit FrameReader(Args && ... args)
+		: _fd(std::forward<Args>(args) ...), _head(0), _tail(0)
+	{
+	}
+
+	FrameReader(const FrameReader &other) = delete;
+	FrameReader &operator=(const FrameReader &other) = delete;
+
+
+	Descriptor &descriptor() noexcept
+	{
+		return _fd;
+	}
+
+	// Number of received bytes not yet returned as frames.
+	//
+	size_t pending() const noexcept
+	{
+		return (_tail - _head);
+	}
+
+
+	// Read once from the descriptor in the free space of the ring.
+	// The handler receives the number of bytes read, 0 at the end of the
+	// stream, or -1 on error.
+	//
+	template<typename ErrHandler>
+	auto fill(ErrHandler &&handler) noexcept (noexcept (handler(-1)))
+	{
+		size_t space = N - pending();
+		size_t pos = _tail % N;
+		struct iovec iov[2];
+		int iovcnt = 1;
+		ssize_t ret;
+
+		if (space == 0) [[unlikely]] {
+			errno = ENOBUFS;
+			return handler(-1);
+		}
+
+		iov[0].iov_base = _buf + pos;
+		iov[0].iov_len = std::min(space, N - pos);
+
+		if (space > iov[0].iov_len) {
+			iov[1].iov_base = _buf;
+			iov[1].iov_len = space - iov[0].iov_len;
+			iovcnt = 2;
+		}
+
+		ret = traced<TracePoint::Read>([&]() {
+			return ::readv(_fd.value(), iov, iovcnt);
+		});
+
+		if (ret > 0)
+			_tail += static_cast<size_t> (ret);
+
+		return handler(ret);
+	}
+
+
+	// Extract the next frame from the received bytes without reading
+	// the descriptor.
+	// The handler receives 1 and `*frame` is set if there is a complete
+	// frame, 0 if more bytes are needed, or -1 with `EMSGSIZE` if the
+	// announced length exceeds `MAX_FRAME`.
+	// The frame stays valid until the next call to `fill()` or `next()`.
+	//
+	template<typename ErrHandler>
+	auto next(std::span<const uint8_t> *frame, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		BigEndian<Length> header;
+		size_t len, start;
+
+		if (pending() < HEADER_SIZE)
+			return handler(0);
+
+		_copy(_head, &header, HEADER_SIZE);
+
+		if (header.load() > MAX_FRAME) [[unlikely]] {
+			errno = EMSGSIZE;
+			return handler(-1);
+		}
+
+		len = static_cast<size_t> (header.load());
+
+		if (pending() < (HEADER_SIZE + len))
+			return handler(0);
+
+		start = (_head + HEADER_SIZE) % N;
+
+		if ((start + len) <= N) {
+			*frame = std::span<const uint8_t>(_buf + start, len);
+		} else {
+			_scratch.resize(len);
+			_copy(_head + HEADER_SIZE, _scratch.data(), len);
+			*frame = std::span<const uint8_t>(_scratch.data(), len);
+		}
+
+		_head += HEADER_SIZE + len;
+
+		// Restart from the beginning of the ring when it is empty so
+		// the next frames are less likely to wrap.
+		if (_head == _tail) {
+			_head = 0;
+			_tail = 0;
+		}
+
+		return handler(1);
+	}
+
+	bool next(std::span<const uint8_t> *frame)
+	{
+		return next(frame, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwframe();
+			return (ret > 0);
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwframe()
+	{
+		SystemException::throwErrno();
+	}
+
+
+	// Return the next frame, reading the descriptor as much as needed.
+	// Return `false` at the end of the stream, and fail with `EPROTO` if
+	// the stream ends in the middle of a frame.
+	//
+	bool read(std::span<const uint8_t> *frame)
+	{
+		auto passthrough = [](ssize_t r) { return r; };
+		ssize_t ret;
+
+		while (next(frame) == false) {
+		retry:
+			if ((ret = fill(passthrough)) < 0) [[unlikely]] {
+				if (errno == EINTR)
+					goto retry;
+				throwread();
+			}
+
+			if (ret == 0) {
+				if (pending() == 0)
+					return false;
+				errno = EPROTO;
+				throwread();
+			}
+		}
+
+		return true;
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwread()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
+};
+
+
+}
+
+
+#endif
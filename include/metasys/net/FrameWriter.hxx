@@ -0,0 +1,143 @@
+#ifndef _INCLUDE_METASYS_NET_FRAMEWRITER_HXX_
+#define _INCLUDE_METASYS_NET_FRAMEWRITER_HXX_
+
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include <metasys/net/FrameReader.hxx>
+#include <metasys/net/bit.hxx>
+#include <metasys/sys/SystemException.hxx>
+#include <metasys/sys/Trace.hxx>
+
+
+namespace metasys {
+
+
+// Writer of messages prefixed by their length as a big-endian `Length`,
+// the counterpart of `FrameReader`.
+// The header and the payload are sent together with `writev()` so the
+// payload is never copied and a frame is never split in two system calls
+// unless the socket buffer fills up.
+// The `Descriptor` is held by value: use a reference type such as
+// `FrameWriter<TcpSocket &>` to wrap a descriptor without owning it.
+//
+template<typename Descriptor, FrameLength Length = uint32_t>
+class FrameWriter
+{
+	Descriptor  _fd;
+
+
+	// Send the `iovcnt` vectors of `iov`, resuming after partial writes
+	// and interruptions, since giving up in the middle of a frame would
+	// corrupt the stream.
+	//
+	ssize_t _sendall(struct iovec *iov, int iovcnt) noexcept
+	{
+		ssize_t ret;
+		size_t done;
+
+		while (iovcnt > 0) {
+			ret = traced<TracePoint::Writev>([&]() {
+				return ::writev(_fd.value(), iov, iovcnt);
+			});
+
+			if (ret < 0) [[unlikely]] {
+				if (errno == EINTR)
+					continue;
+				return ret;
+			}
+
+			done = static_cast<size_t> (ret);
+
+			while ((iovcnt > 0) && (done >= iov->iov_len)) {
+				done -= iov->iov_len;
+				iov += 1;
+				iovcnt -= 1;
+			}
+
+			if (iovcnt > 0) {
+				iov->iov_base = static_cast<uint8_t *>
+					(iov->iov_base) + done;
+				iov->iov_len -= done;
+			}
+		}
+
+		return 0;
+	}
+
+
+ public:
+	static constexpr size_t HEADER_SIZE = sizeof (Length);
+
+
+	template<typename ... Args>
+	explicit FrameWriter(Args && ... args)
+		: _fd(std::forward<Args>(args) ...)
+	{
+	}
+
+
+	Descriptor &descriptor() noexcept
+	{
+		return _fd;
+	}
+
+
+	// Send a frame of `len` bytes at `src`.
+	// The handler receives 0 once the whole frame is sent or -1 on error.
+	// A frame too large for `Length` fails with `EMSGSIZE` before
+	// anything is sent. After other errors, the stream may end in the
+	// middle of a frame and should be closed.
+	//
+	template<typename ErrHandler>
+	auto write(const void *src, size_t len, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		BigEndian<Length> header = static_cast<Length> (len);
+		struct iovec iov[2];
+
+		if (len > std::numeric_limits<Length>::max()) [[unlikely]] {
+			errno = EMSGSIZE;
+			return handler(-1);
+		}
+
+		iov[0].iov_base = &header;
+		iov[0].iov_len = HEADER_SIZE;
+		iov[1].iov_base = const_cast<void *> (src);
+		iov[1].iov_len = len;
+
+		return handler(_sendall(iov, (len > 0) ? 2 : 1));
+	}
+
+	void write(const void *src, size_t len)
+	{
+		write(src, len, [](ssize_t ret) {
+			if (ret < 0) [[unlikely]]
+				throwwrite();
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwwrite()
+	{
+		assert(errno != EBADF);
+		assert(errno != EFAULT);
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
+};
+
+
+}
+
+
+#endif
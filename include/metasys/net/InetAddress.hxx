@@ -24,9 +24,12 @@
 #include <netinet/in.h>
 #include <sys/types.h>
 
+#include <cassert>
 #include <cstdint>
 
 #include <compare>
+#include <span>
+#include <type_traits>
 
 #include <metasys/net/bit.hxx>
 
@@ -36,31 +39,43 @@ namespace metasys {
 
 class InetAddress
 {
-	struct sockaddr_in  _sin {};
+	// Only the fields used by the kernel are initialized at runtime.
+	// The `sin_zero` padding is left as is, like in hand written code,
+	// unless in a constant expression which cannot copy indeterminate
+	// values.
+	struct sockaddr_in  _sin;
 
 
- public:
-	constexpr InetAddress() noexcept
+	constexpr void _pad() noexcept
 	{
-		_sin.sin_family = AF_INET;
+		if (std::is_constant_evaluated())
+			for (unsigned char &c : _sin.sin_zero)
+				c = 0;
 	}
 
-	constexpr InetAddress(uint16_t port) noexcept
+	constexpr void _init(uint32_t ip, uint16_t port) noexcept
 	{
 		_sin.sin_family = AF_INET;
 		_sin.sin_port = hton(port);
-		_sin.sin_addr.s_addr = hton(INADDR_ANY);
+		_sin.sin_addr.s_addr = hton(ip);
+		_pad();
 	}
 
-	constexpr static InetAddress localhost(uint16_t port) noexcept
+
+ public:
+	constexpr InetAddress() noexcept
 	{
-		InetAddress ret;
+		_init(INADDR_ANY, 0);
+	}
 
-		ret._sin.sin_family = AF_INET;
-		ret._sin.sin_port = hton(port);
-		ret._sin.sin_addr.s_addr = hton(INADDR_LOOPBACK);
+	constexpr InetAddress(uint16_t port) noexcept
+	{
+		_init(INADDR_ANY, port);
+	}
 
-		return ret;
+	constexpr static InetAddress localhost(uint16_t port) noexcept
+	{
+		return InetAddress(127, 0, 0, 1, port);
 	}
 
 	constexpr InetAddress(const uint8_t ip[4], uint16_t port) noexcept
@@ -69,16 +84,14 @@ class InetAddress
 		_sin.sin_port = hton(port);
 		_sin.sin_addr.s_addr =
 			*(reinterpret_cast<const uint32_t *> (ip));
+		_pad();
 	}
 
 	constexpr InetAddress(uint8_t ip0, uint8_t ip1, uint8_t ip2,
 			      uint8_t ip3, uint16_t port) noexcept
 	{
-		_sin.sin_family = AF_INET;
-		_sin.sin_port = hton(port);
-		_sin.sin_addr.s_addr = hton((ip0 << 24) | (ip1 << 16)
-					    | (ip2 << 8)
-					    | static_cast<uint32_t> (ip3));
+		_init((static_cast<uint32_t> (ip0) << 24) | (ip1 << 16)
+		      | (ip2 << 8) | ip3, port);
 	}
 
 	explicit constexpr InetAddress(const struct sockaddr_in *sin) noexcept
@@ -86,6 +99,34 @@ class InetAddress
 	{
 	}
 
+	// Set `dest[i]` to the IPv4 address `ips[i]` and the port `ports[i]`,
+	// both in host byte order, e.g. to build the addresses of many peers
+	// at once.
+	//
+	constexpr static void fill(std::span<InetAddress> dest,
+				   std::span<const uint32_t> ips,
+				   std::span<const uint16_t> ports) noexcept
+	{
+		size_t i;
+
+		assert(ips.size() == dest.size());
+		assert(ports.size() == dest.size());
+
+		for (i = 0; i < dest.size(); i++)
+			dest[i]._init(ips[i], ports[i]);
+	}
+
+	// Set `dest[i]` to the IPv4 address `ip` and the port `port + i`.
+	//
+	constexpr static void fill(std::span<InetAddress> dest, uint32_t ip,
+				   uint16_t port) noexcept
+	{
+		size_t i;
+
+		for (i = 0; i < dest.size(); i++)
+			dest[i]._init(ip, static_cast<uint16_t> (port + i));
+	}
+
 	constexpr InetAddress(const InetAddress &other) noexcept = default;
 	constexpr InetAddress(InetAddress &&other) noexcept = default;
 
@@ -105,6 +146,12 @@ class InetAddress
 		return (port() <=> other.port());
 	}
 
+	bool operator==(const InetAddress &other) const noexcept
+	{
+		return ((_sin.sin_addr.s_addr == other._sin.sin_addr.s_addr)
+			&& (_sin.sin_port == other._sin.sin_port));
+	}
+
 
 	struct sockaddr_in *saddrin() noexcept
 	{
@@ -77,6 +77,7 @@ class SocketDescriptor : public ClosingDescriptor
 		});
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwopen()
 	{
 		assert(errno != EINVAL);
@@ -123,6 +124,7 @@ class SocketDescriptor : public ClosingDescriptor
 		setsockopt(level, optname, &optval, sizeof (optval));
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwsetsockopt()
 	{
 		assert(errno != EBADF);
@@ -8,6 +8,7 @@
 #include <metasys/net/TcpSocket.hxx>
 #include <metasys/net/TcpSocketDescriptor.hxx>
 #include <metasys/sys/SystemException.hxx>
+#include <metasys/sys/Trace.hxx>
 
 
 namespace metasys {
@@ -30,9 +31,11 @@ class TcpServerSocket : public details::TcpSocketDescriptor
 
 		assert(valid());
 
-		ret = ::accept4(value(),
-				reinterpret_cast<struct sockaddr *> (from),
-				&slen, flags);
+		ret = traced<TracePoint::Accept>([&]() {
+			return ::accept4(value(), reinterpret_cast
+					 <struct sockaddr *> (from),
+					 &slen, flags);
+		});
 
 		assert(slen == sizeof (*from));
 
@@ -97,6 +100,7 @@ class TcpServerSocket : public details::TcpSocketDescriptor
 			      flags);
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwaccept()
 	{
 		assert(errno != EBADF);
@@ -216,6 +220,7 @@ class TcpServerSocket : public details::TcpSocketDescriptor
 		return listeninit<ReusePort>(addr.saddrin(), backlog, flags);
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwlisten()
 	{
 		assert(errno != EBADF);
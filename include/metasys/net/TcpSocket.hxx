@@ -11,6 +11,7 @@
 #include <metasys/net/InetAddress.hxx>
 #include <metasys/net/TcpSocketDescriptor.hxx>
 #include <metasys/sys/SystemException.hxx>
+#include <metasys/sys/Trace.hxx>
 
 
 namespace metasys {
@@ -44,7 +45,9 @@ class TcpSocket : public details::TcpSocketBase
 		assert(valid());
 
 		saddr = reinterpret_cast<const struct sockaddr *> (addr);
-		ret = ::connect(value(), saddr, sizeof (*addr));
+		ret = traced<TracePoint::Connect>([&]() {
+			return ::connect(value(), saddr, sizeof (*addr));
+		});
 
 		return handler(ret);
 	}
@@ -70,6 +73,7 @@ class TcpSocket : public details::TcpSocketBase
 		connect(addr.saddrin());
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwconnect()
 	{
 		assert(errno != EAFNOSUPPORT);
@@ -107,6 +111,7 @@ class TcpSocket : public details::TcpSocketBase
 		});
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwdisconnect()
 	{
 		throwconnect();
@@ -3,6 +3,7 @@
 
 
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 
 #include <metasys/net/InetAddress.hxx>
@@ -61,6 +62,7 @@ class TcpSocketDescriptor : public TcpSocketDescriptorBase
 		bind(addr.saddrin());
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwbind()
 	{
 		assert(errno != EBADF);
@@ -107,6 +109,43 @@ class TcpSocketDescriptor : public TcpSocketDescriptorBase
 				throwsetsockopt();
 		});
 	}
+
+	// While corked, the kernel only sends full segments and holds partial
+	// ones until uncorked (or for at most 200 ms).
+	//
+	template<typename ErrHandler>
+	auto setcork(bool cork, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return setsockopt(IPPROTO_TCP, TCP_CORK,
+				  static_cast<int> (cork),
+				  std::forward<ErrHandler>(handler));
+	}
+
+	void setcork(bool cork)
+	{
+		setcork(cork, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwsetsockopt();
+		});
+	}
+
+	template<typename ErrHandler>
+	auto setnodelay(bool nodelay, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return setsockopt(IPPROTO_TCP, TCP_NODELAY,
+				  static_cast<int> (nodelay),
+				  std::forward<ErrHandler>(handler));
+	}
+
+	void setnodelay(bool nodelay)
+	{
+		setnodelay(nodelay, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwsetsockopt();
+		});
+	}
 };
 
 
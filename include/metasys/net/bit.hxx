@@ -21,9 +21,15 @@
 #define _INCLUDE_METASYS_NET_BITS_HXX_
 
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 
+#include <algorithm>
+#include <array>
 #include <bit>
+#include <span>
+#include <type_traits>
 
 
 namespace metasys {
@@ -116,6 +122,243 @@ constexpr uint64_t ntoh(uint64_t value) noexcept
 }
 
 
+// Bulk conversions of arrays of integers, typically the payload of a wire
+// message.
+// At runtime, the arrays are byte swapped with SSSE3 or AVX2 shuffles,
+// selected once at startup from CPUID. At compile time, the scalar path
+// above is used.
+// The destination must be as large as the source and may be the same
+// array, but must not partially overlap with it.
+//
+enum class BswapIsa
+{
+	Scalar,
+	Ssse3,
+	Avx2
+};
+
+
+// Same as the bulk `bswap()` below with an explicit instruction set, which
+// must be supported by the running CPU.
+//
+void bswap(std::span<const uint16_t> src, std::span<uint16_t> dest,
+	   BswapIsa isa) noexcept;
+void bswap(std::span<const uint32_t> src, std::span<uint32_t> dest,
+	   BswapIsa isa) noexcept;
+void bswap(std::span<const uint64_t> src, std::span<uint64_t> dest,
+	   BswapIsa isa) noexcept;
+
+// Best instruction set of the running CPU.
+//
+BswapIsa bswapisa() noexcept;
+
+
+namespace detail {
+
+
+template<typename T>
+constexpr void bswap(std::span<const T> src, std::span<T> dest) noexcept
+{
+	size_t i;
+
+	assert(dest.size() >= src.size());
+
+	if (std::is_constant_evaluated()) {
+		for (i = 0; i < src.size(); i++)
+			dest[i] = metasys::bswap(src[i]);
+	} else {
+		metasys::bswap(src, dest, bswapisa());
+	}
+}
+
+template<typename T>
+constexpr void hton(std::span<const T> src, std::span<T> dest) noexcept
+{
+	if constexpr (std::endian::native == std::endian::little) {
+		detail::bswap(src, dest);
+	} else if (src.data() != dest.data()) {
+		assert(dest.size() >= src.size());
+		std::copy(src.begin(), src.end(), dest.begin());
+	}
+}
+
+
+}
+
+
+constexpr void bswap(std::span<const uint16_t> src, std::span<uint16_t> dest)
+	noexcept
+{
+	detail::bswap(src, dest);
+}
+
+constexpr void bswap(std::span<const uint32_t> src, std::span<uint32_t> dest)
+	noexcept
+{
+	detail::bswap(src, dest);
+}
+
+constexpr void bswap(std::span<const uint64_t> src, std::span<uint64_t> dest)
+	noexcept
+{
+	detail::bswap(src, dest);
+}
+
+constexpr void bswap(std::span<uint16_t> data) noexcept
+{
+	detail::bswap<uint16_t>(data, data);
+}
+
+constexpr void bswap(std::span<uint32_t> data) noexcept
+{
+	detail::bswap<uint32_t>(data, data);
+}
+
+constexpr void bswap(std::span<uint64_t> data) noexcept
+{
+	detail::bswap<uint64_t>(data, data);
+}
+
+
+constexpr void hton(std::span<const uint16_t> src, std::span<uint16_t> dest)
+	noexcept
+{
+	detail::hton(src, dest);
+}
+
+constexpr void hton(std::span<const uint32_t> src, std::span<uint32_t> dest)
+	noexcept
+{
+	detail::hton(src, dest);
+}
+
+constexpr void hton(std::span<const uint64_t> src, std::span<uint64_t> dest)
+	noexcept
+{
+	detail::hton(src, dest);
+}
+
+constexpr void hton(std::span<uint16_t> data) noexcept
+{
+	detail::hton<uint16_t>(data, data);
+}
+
+constexpr void hton(std::span<uint32_t> data) noexcept
+{
+	detail::hton<uint32_t>(data, data);
+}
+
+constexpr void hton(std::span<uint64_t> data) noexcept
+{
+	detail::hton<uint64_t>(data, data);
+}
+
+
+constexpr void ntoh(std::span<const uint16_t> src, std::span<uint16_t> dest)
+	noexcept
+{
+	detail::hton(src, dest);
+}
+
+constexpr void ntoh(std::span<const uint32_t> src, std::span<uint32_t> dest)
+	noexcept
+{
+	detail::hton(src, dest);
+}
+
+constexpr void ntoh(std::span<const uint64_t> src, std::span<uint64_t> dest)
+	noexcept
+{
+	detail::hton(src, dest);
+}
+
+constexpr void ntoh(std::span<uint16_t> data) noexcept
+{
+	detail::hton<uint16_t>(data, data);
+}
+
+constexpr void ntoh(std::span<uint32_t> data) noexcept
+{
+	detail::hton<uint32_t>(data, data);
+}
+
+constexpr void ntoh(std::span<uint64_t> data) noexcept
+{
+	detail::hton<uint64_t>(data, data);
+}
+
+
+// Unsigned integer stored in network byte order and converted on access.
+// The storage is a plain array of bytes so the type has no alignment
+// requirement: packed wire structures made of these can be read in place
+// from a receive buffer at any offset.
+//
+template<typename T>
+class BigEndian
+{
+	std::array<uint8_t, sizeof (T)>  _bytes;
+
+
+ public:
+	BigEndian() noexcept = default;
+
+	constexpr BigEndian(T value) noexcept
+	{
+		store(value);
+	}
+
+	constexpr BigEndian(const BigEndian &other) noexcept = default;
+
+	constexpr BigEndian &operator=(const BigEndian &other) noexcept =
+		default;
+
+	constexpr BigEndian &operator=(T value) noexcept
+	{
+		store(value);
+		return *this;
+	}
+
+
+	// Value in host byte order.
+	//
+	constexpr T load() const noexcept
+	{
+		return ntoh(raw());
+	}
+
+	constexpr operator T() const noexcept
+	{
+		return load();
+	}
+
+	constexpr void store(T value) noexcept
+	{
+		setraw(hton(value));
+	}
+
+	// Value in network byte order.
+	//
+	constexpr T raw() const noexcept
+	{
+		return std::bit_cast<T>(_bytes);
+	}
+
+	constexpr void setraw(T raw) noexcept
+	{
+		_bytes = std::bit_cast<decltype (_bytes)>(raw);
+	}
+};
+
+
+using be_uint16_t = BigEndian<uint16_t>;
+using be_uint32_t = BigEndian<uint32_t>;
+using be_uint64_t = BigEndian<uint64_t>;
+
+static_assert (sizeof (be_uint64_t) == sizeof (uint64_t));
+static_assert (alignof (be_uint64_t) == 1);
+static_assert (std::is_trivially_copyable_v<be_uint64_t>);
+
+
 }
 
 
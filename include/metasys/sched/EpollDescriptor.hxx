@@ -10,6 +10,7 @@
 
 #include <metasys/sys/ClosingDescriptor.hxx>
 #include <metasys/sys/SystemException.hxx>
+#include <metasys/sys/Trace.hxx>
 
 
 namespace metasys {
@@ -147,6 +148,7 @@ class EpollDescriptor : public ClosingDescriptor
 		});
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwcreate()
 	{
 		assert(errno != EINVAL);
@@ -187,6 +189,7 @@ class EpollDescriptor : public ClosingDescriptor
 			   std::forward<Args>(args) ...);
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwctl()
 	{
 		assert(errno != EBADF);
@@ -276,8 +279,10 @@ class EpollDescriptor : public ClosingDescriptor
 	{
 		assert(valid());
 
-		return handler(::epoll_wait(value(), events, maxevents,
-					    timeout));
+		return handler(traced<TracePoint::EpollWait>([&]() {
+			return ::epoll_wait(value(), events, maxevents,
+					    timeout);
+		}));
 	}
 
 	template<typename ErrHandler>
@@ -296,7 +301,10 @@ class EpollDescriptor : public ClosingDescriptor
 		assert(valid());
 
 	retry:
-		ret = ::epoll_wait(value(), events, maxevents, timeout);
+		ret = traced<TracePoint::EpollWait>([&]() {
+			return ::epoll_wait(value(), events, maxevents,
+					    timeout);
+		});
 
 		if (ret < 0) [[unlikely]] {
 			if (errno == EINTR)
@@ -309,6 +317,7 @@ class EpollDescriptor : public ClosingDescriptor
 		return ((size_t) ret);
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwwait()
 	{
 		assert(errno != EBADF);
@@ -0,0 +1,119 @@
+#ifndef _INCLUDE_METASYS_SCHED_PERCPU_HXX_
+#define _INCLUDE_METASYS_SCHED_PERCPU_HXX_
+
+
+#include <sched.h>
+#include <sys/sysinfo.h>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+
+namespace metasys {
+
+
+// One `T` per possible CPU, each on its own cache lines, so threads running
+// on different CPUs never write to the same line.
+// `local()` picks the slot of the CPU the caller runs on with
+// `sched_getcpu()`, which glibc serves from its `rseq` area without a
+// system call. The caller may migrate right after, so the slots must still
+// be updated with atomic instructions, but these are uncontended in the
+// common case.
+//
+template<typename T>
+class PerCpu
+{
+	struct alignas(64) Slot
+	{
+		T  value;
+	};
+
+
+	std::unique_ptr<Slot[]>  _slots;
+	size_t                   _size;
+	bool                     _complete;
+
+
+ public:
+	PerCpu()
+		: PerCpu(cpus())
+	{
+	}
+
+	explicit PerCpu(size_t ncpus)
+		: _slots(new Slot[ncpus]()), _size(ncpus),
+		  _complete(ncpus >= cpus())
+	{
+		assert(ncpus > 0);
+	}
+
+
+	// Number of CPUs the system may bring online.
+	//
+	static size_t cpus() noexcept
+	{
+		int ret = ::get_nprocs_conf();
+
+		if (ret < 1) [[unlikely]]
+			return 1;
+
+		return static_cast<size_t> (ret);
+	}
+
+	// CPU the caller is running on, or 0 if this cannot be known.
+	//
+	static size_t cpu() noexcept
+	{
+		int ret = ::sched_getcpu();
+
+		if (ret < 0) [[unlikely]]
+			return 0;
+
+		return static_cast<size_t> (ret);
+	}
+
+
+	size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	// Whether every CPU has its own slot, so that two threads running at
+	// the same time never use the same slot.
+	//
+	bool complete() const noexcept
+	{
+		return _complete;
+	}
+
+	T &operator[](size_t index) noexcept
+	{
+		assert(index < _size);
+
+		return _slots[index].value;
+	}
+
+	const T &operator[](size_t index) const noexcept
+	{
+		assert(index < _size);
+
+		return _slots[index].value;
+	}
+
+	T &local() noexcept
+	{
+		size_t index = cpu();
+
+		if (index >= _size) [[unlikely]]
+			index %= _size;
+
+		return _slots[index].value;
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef _INCLUDE_METASYS_SCHED_PERCPUFREELIST_HXX_
+#define _INCLUDE_METASYS_SCHED_PERCPUFREELIST_HXX_
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <metasys/sched/PerCpu.hxx>
+#include <metasys/sched/PthreadMutex.hxx>
+#include <metasys/sched/Rseq.hxx>
+
+
+namespace metasys {
+
+
+// One stack of free objects per CPU, linked through the first word of the
+// objects, which must be at least pointer sized and aligned.
+// A stack is only ever used by the threads running on its CPU, so pushes
+// and pops are restartable sequences with no atomic instruction. Without
+// restartable sequences, each stack is protected by a mutex instead.
+// Threads which have no `Rseq::area()` while the process uses restartable
+// sequences share one more stack, also protected by a mutex, so the two
+// methods are never mixed on a same stack.
+// `pop()` does not take objects from the stacks of other CPUs: an allocator
+// on top should refill the stack of the current CPU when it is empty.
+//
+class PerCpuFreeList
+{
+	struct Stack
+	{
+		void          *head;
+		PthreadMutex   lock;
+	};
+
+
+	PerCpu<Stack>  _stacks;
+	Stack          _shared = {};
+
+
+	// Stack to use under its mutex by a thread which cannot run a
+	// restartable sequence on its CPU.
+	//
+	Stack &_locked() noexcept
+	{
+		if (Rseq::enabled())
+			return _shared;
+
+		return _stacks.local();
+	}
+
+	static void _push(Stack &stack, void *node) noexcept
+	{
+		stack.lock.lock();
+		*static_cast<void **> (node) = stack.head;
+		stack.head = node;
+		stack.lock.unlock();
+	}
+
+	static void *_pop(Stack &stack) noexcept
+	{
+		void *ret;
+
+		stack.lock.lock();
+		ret = stack.head;
+		if (ret != nullptr)
+			stack.head = *static_cast<void **> (ret);
+		stack.lock.unlock();
+
+		return ret;
+	}
+
+
+ public:
+	PerCpuFreeList() = default;
+
+
+	void push(void *node) noexcept
+	{
+		struct rseq *area;
+		uint32_t cpu;
+
+		if (Rseq::enabled()) [[likely]] {
+			area = Rseq::area();
+
+			while (area != nullptr) {
+				cpu = Rseq::cpu(area);
+
+				if (cpu >= _stacks.size()) [[unlikely]]
+					break;
+
+				if (Rseq::trypush(area, cpu,
+						  &_stacks[cpu].head, node))
+					return;
+			}
+		}
+
+		_push(_locked(), node);
+	}
+
+	void *pop() noexcept
+	{
+		struct rseq *area;
+		uint32_t cpu;
+		void *ret;
+
+		if (Rseq::enabled()) [[likely]] {
+			area = Rseq::area();
+
+			while (area != nullptr) {
+				cpu = Rseq::cpu(area);
+
+				if (cpu >= _stacks.size()) [[unlikely]]
+					break;
+
+				if (Rseq::trypop(area, cpu,
+						 &_stacks[cpu].head, &ret))
+					return ret;
+			}
+		}
+
+		return _pop(_locked());
+	}
+
+
+	// Empty all the stacks, calling `visitor(node)` for every object
+	// removed, typically to release them before destroying the list.
+	// No other thread must use the list meanwhile.
+	//
+	template<typename Visitor>
+	void clear(Visitor &&visitor)
+	{
+		void *node;
+		size_t i;
+
+		for (i = 0; i < _stacks.size(); i++) {
+			while ((node = _stacks[i].head) != nullptr) {
+				_stacks[i].head = *static_cast<void **> (node);
+				visitor(node);
+			}
+		}
+
+		while ((node = _shared.head) != nullptr) {
+			_shared.head = *static_cast<void **> (node);
+			visitor(node);
+		}
+	}
+};
+
+
+}
+
+
+#endif
@@ -2,7 +2,9 @@
 #define _INCLUDE_METASYS_SCHED_PROCESS_HXX_
 
 
+#include <fcntl.h>
 #include <signal.h>
+#include <sys/epoll.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -12,8 +14,14 @@
 #include <csignal>
 #include <cstdlib>
 #include <functional>
+#include <string>
 
+#include <metasys/io/Pipe.hxx>
+#include <metasys/io/ReadableDescriptor.hxx>
+#include <metasys/io/WritableDescriptor.hxx>
 #include <metasys/meta/AutoHolder.hxx>
+#include <metasys/meta/StaticOptional.hxx>
+#include <metasys/sched/EpollDescriptor.hxx>
 #include <metasys/sched/ProcessBehavior.hxx>
 #include <metasys/sys/SystemException.hxx>
 
@@ -24,13 +32,42 @@ namespace metasys {
 template<ProcessBehavior Behavior = ProcessBehavior::DEFAULT()>
 class Process
 {
+	static constexpr bool CAPTURE = Behavior.CaptureStdin
+		|| Behavior.CaptureStdout || Behavior.CaptureStderr;
+
+
 	pid_t   _pid;
 
+	struct Streams
+	{
+		Pipe::Writer  in;
+		Pipe::Reader  out;
+		Pipe::Reader  err;
+	};
+
+	[[no_unique_address]]
+	details::StaticOptional<CAPTURE, Streams>  _streams;
+
+
+	void _release() noexcept
+	{
+		int stream;
+
+		for (stream = STDIN_FILENO; stream <= STDERR_FILENO; stream++)
+			if (_streamfd(stream) >= 0)
+				_streamclose(stream);
+	}
 
 	void _stop() noexcept
 	{
 		assert(valid());
 
+		// Close the captured streams before to wait so a child blocked
+		// on a full pipe does not deadlock with its parent.
+		if constexpr (CAPTURE) {
+			_release();
+		}
+
 		if constexpr (Behavior.SignalOnDestroy != 0) {
 			kill(Behavior.SignalOnDestroy, [](int){});
 		}
@@ -56,6 +93,7 @@ class Process
 
 	Process(Process &&other) noexcept
 		: _pid(other._pid)
+		, _streams(std::move(other._streams))
 	{
 		other._pid = 0;
 	}
@@ -80,6 +118,8 @@ class Process
 		other._pid = 0;
 		_pid = tmp;
 
+		_streams = std::move(other._streams);
+
 		return *this;
 	}
 
@@ -104,12 +144,143 @@ class Process
 	}
 
 
+	WritableDescriptor stdin() const noexcept
+		requires (Behavior.CaptureStdin)
+	{
+		return WritableDescriptor(_streams.value().in.value());
+	}
+
+	ReadableDescriptor stdout() const noexcept
+		requires (Behavior.CaptureStdout)
+	{
+		return ReadableDescriptor(_streams.value().out.value());
+	}
+
+	ReadableDescriptor stderr() const noexcept
+		requires (Behavior.CaptureStderr)
+	{
+		return ReadableDescriptor(_streams.value().err.value());
+	}
+
+
+ private:
+	// Note: The pipes are created with `O_CLOEXEC | O_NONBLOCK` so the
+	//       parent ends never leak in an exec'ed program and can be
+	//       multiplexed with `epoll`.
+	//       The child ends are open file descriptions distinct from the
+	//       parent ones, so the child can safely clear `O_NONBLOCK` on
+	//       its standard streams after the `dup2()`.
+
+	static void _redirect(int fd, int target) noexcept
+	{
+		[[maybe_unused]] int ret;
+		int flags;
+
+		ret = ::dup2(fd, target);
+		assert(ret == target);
+
+		flags = ::fcntl(target, F_GETFL);
+		assert(flags >= 0);
+
+		ret = ::fcntl(target, F_SETFL, flags & ~O_NONBLOCK);
+		assert(ret == 0);
+
+		::close(fd);
+	}
+
+	static void _setupchild(int fds[3]) noexcept
+	{
+		int i, tmp;
+
+		// If the parent runs with some standard streams closed, the
+		// pipes may occupy the slots we are about to overwrite.
+		for (i = STDIN_FILENO; i <= STDERR_FILENO; i++) {
+			if ((fds[i] < 0) || (fds[i] > STDERR_FILENO))
+				continue;
+
+			tmp = ::fcntl(fds[i], F_DUPFD_CLOEXEC,
+				      STDERR_FILENO + 1);
+
+			assert(tmp > STDERR_FILENO);
+
+			::close(fds[i]);
+			fds[i] = tmp;
+		}
+
+		for (i = STDIN_FILENO; i <= STDERR_FILENO; i++)
+			if (fds[i] >= 0)
+				_redirect(fds[i], i);
+	}
+
+	pid_t _forkcapture() noexcept
+	{
+		constexpr int flags = O_CLOEXEC | O_NONBLOCK;
+		auto passthrough = [](int r) { return r; };
+		Pipe in, out, err;
+		int fds[3] = { -1, -1, -1 };
+		pid_t pid;
+
+		if constexpr (Behavior.CaptureStdin) {
+			if (in.open(flags, passthrough) != 0) [[unlikely]]
+				return -1;
+		}
+
+		if constexpr (Behavior.CaptureStdout) {
+			if (out.open(flags, passthrough) != 0) [[unlikely]]
+				return -1;
+		}
+
+		if constexpr (Behavior.CaptureStderr) {
+			if (err.open(flags, passthrough) != 0) [[unlikely]]
+				return -1;
+		}
+
+		if ((pid = ::fork()) < 0) [[unlikely]]
+			return pid;
+
+		if (pid == 0) {
+			// Close the parent ends first so they cannot be
+			// mistaken for the standard streams after the dup2().
+			if constexpr (Behavior.CaptureStdin) {
+				in.wmove().close([](int){});
+				fds[STDIN_FILENO] = in.rmove().reset();
+			}
+			if constexpr (Behavior.CaptureStdout) {
+				out.rmove().close([](int){});
+				fds[STDOUT_FILENO] = out.wmove().reset();
+			}
+			if constexpr (Behavior.CaptureStderr) {
+				err.rmove().close([](int){});
+				fds[STDERR_FILENO] = err.wmove().reset();
+			}
+
+			_setupchild(fds);
+
+			return pid;
+		}
+
+		if constexpr (Behavior.CaptureStdin)
+			_streams.value().in = in.wmove();
+		if constexpr (Behavior.CaptureStdout)
+			_streams.value().out = out.rmove();
+		if constexpr (Behavior.CaptureStderr)
+			_streams.value().err = err.rmove();
+
+		return pid;
+	}
+
+
+ public:
 	template<typename ErrHandler>
 	auto fork(ErrHandler &&handler) noexcept (noexcept (handler(-1)))
 	{
 		assert(valid() == false);
 
-		_pid = ::fork();
+		if constexpr (CAPTURE) {
+			_pid = _forkcapture();
+		} else {
+			_pid = ::fork();
+		}
 
 		return handler(_pid);
 	}
@@ -125,11 +296,21 @@ class Process
 	template<typename ErrHandler>
 	static Process forkinit(ErrHandler &&handler)
 	{
-		pid_t pid = ::fork();
+		if constexpr (CAPTURE) {
+			Process ret;
+
+			ret._pid = ret._forkcapture();
 
-		handler(pid);
+			handler(ret._pid);
 
-		return Process(pid);
+			return ret;
+		} else {
+			pid_t pid = ::fork();
+
+			handler(pid);
+
+			return Process(pid);
+		}
 	}
 
 	static Process forkinit()
@@ -209,6 +390,7 @@ class Process
 	// }
 
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwfork()
 	{
 		SystemException::throwErrno();
@@ -246,6 +428,7 @@ class Process
 		});
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwwait()
 	{
 		assert(errno != ECHILD);
@@ -272,12 +455,214 @@ class Process
 		});
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void throwkill()
 	{
 		assert(errno != EINVAL);
 
 		SystemException::throwErrno();
 	}
+
+
+ private:
+	int _streamfd(int stream) const noexcept
+	{
+		if constexpr (Behavior.CaptureStdin) {
+			if (stream == STDIN_FILENO)
+				return _streams.value().in.value();
+		}
+
+		if constexpr (Behavior.CaptureStdout) {
+			if (stream == STDOUT_FILENO)
+				return _streams.value().out.value();
+		}
+
+		if constexpr (Behavior.CaptureStderr) {
+			if (stream == STDERR_FILENO)
+				return _streams.value().err.value();
+		}
+
+		return -1;
+	}
+
+	void _streamclose(int stream) noexcept
+	{
+		if constexpr (Behavior.CaptureStdin) {
+			if (stream == STDIN_FILENO)
+				_streams.value().in.close([](int){});
+		}
+
+		if constexpr (Behavior.CaptureStdout) {
+			if (stream == STDOUT_FILENO)
+				_streams.value().out.close([](int){});
+		}
+
+		if constexpr (Behavior.CaptureStderr) {
+			if (stream == STDERR_FILENO)
+				_streams.value().err.close([](int){});
+		}
+	}
+
+	// These return 1 if the stream must be polled again, 0 once it is
+	// done and -1 on error.
+
+	static int _feed(int fd, uint32_t events, const uint8_t **src,
+			 size_t *len) noexcept
+	{
+		ssize_t ret;
+
+		if (events & EPOLLERR)
+			return 0;
+
+		if ((ret = ::write(fd, *src, *len)) < 0) {
+			if ((errno == EAGAIN) || (errno == EINTR))
+				return 1;
+			if (errno == EPIPE)
+				return 0;
+			return -1;
+		}
+
+		*src += ret;
+		*len -= ret;
+
+		return (*len > 0);
+	}
+
+	static int _drain(int fd, std::string *dest) noexcept
+	{
+		char buf[16384];
+		ssize_t ret;
+
+		if ((ret = ::read(fd, buf, sizeof (buf))) < 0) {
+			if ((errno == EAGAIN) || (errno == EINTR))
+				return 1;
+			return -1;
+		}
+
+		if ((ret > 0) && (dest != nullptr))
+			dest->append(buf, ret);
+
+		return (ret > 0);
+	}
+
+
+ public:
+	// Feed `input` to the child standard input and collect its standard
+	// output and error until they reach end of file.
+	// All the captured streams are multiplexed through a single `epoll`
+	// instance so a child filling one pipe while its parent writes to or
+	// reads from another cannot deadlock.
+	// Arguments for streams which are not captured are ignored and a null
+	// `output` or `error` discards what the child writes.
+	// On success, all the captured streams are closed.
+	//
+	template<typename ErrHandler>
+	requires (CAPTURE)
+	auto communicate(const void *input, size_t inlen, std::string *output,
+			 std::string *error, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		const uint8_t *src = static_cast<const uint8_t *> (input);
+		auto passthrough = [](int r) { return r; };
+		EpollEvent<int> events[3];
+		EpollDescriptor epoll;
+		int stream, fd, n, i;
+		uint32_t flags;
+		size_t live = 0;
+		int ret = -1;
+
+		assert(valid());
+
+		if (epoll.create(passthrough) < 0) [[unlikely]]
+			goto err;
+
+		for (stream = STDIN_FILENO; stream <= STDERR_FILENO; stream++) {
+			if ((fd = _streamfd(stream)) < 0)
+				continue;
+
+			if (stream == STDIN_FILENO) {
+				if ((src == nullptr) || (inlen == 0)) {
+					_streamclose(stream);
+					continue;
+				}
+				flags = EPOLLOUT;
+			} else {
+				flags = EPOLLIN;
+			}
+
+			if (epoll.add(fd, EpollEvent<int>(flags, stream),
+				      passthrough) < 0) [[unlikely]]
+				goto err;
+
+			live += 1;
+		}
+
+		while (live > 0) {
+			if ((n = epoll.wait(events, 3, passthrough)) < 0) {
+				if (errno == EINTR)
+					continue;
+				ret = -1;
+				goto err;
+			}
+
+			for (i = 0; i < n; i++) {
+				stream = events[i].data();
+				fd = _streamfd(stream);
+
+				if (stream == STDIN_FILENO)
+					ret = _feed(fd, events[i].events(),
+						    &src, &inlen);
+				else if (stream == STDOUT_FILENO)
+					ret = _drain(fd, output);
+				else
+					ret = _drain(fd, error);
+
+				if (ret < 0) [[unlikely]]
+					goto err;
+
+				if (ret > 0)
+					continue;
+
+				epoll.ctl(EPOLL_CTL_DEL, fd, nullptr, passthrough);
+				_streamclose(stream);
+				live -= 1;
+			}
+		}
+
+		ret = 0;
+	 err:
+		return handler(ret);
+	}
+
+	void communicate(const void *input = nullptr, size_t inlen = 0,
+			 std::string *output = nullptr,
+			 std::string *error = nullptr)
+		requires (CAPTURE)
+	{
+		communicate(input, inlen, output, error, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwcommunicate();
+		});
+	}
+
+	void communicate(const std::string &input,
+			 std::string *output = nullptr,
+			 std::string *error = nullptr)
+		requires (CAPTURE)
+	{
+		communicate(input.data(), input.size(), output, error);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwcommunicate()
+	{
+		assert(errno != EBADF);
+		assert(errno != EEXIST);
+		assert(errno != EFAULT);
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
 };
 
 
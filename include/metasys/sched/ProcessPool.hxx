@@ -0,0 +1,426 @@
+#ifndef _INCLUDE_METASYS_SCHED_PROCESSPOOL_HXX_
+#define _INCLUDE_METASYS_SCHED_PROCESSPOOL_HXX_
+
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <metasys/sched/Process.hxx>
+#include <metasys/sched/ProcessBehavior.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+namespace metasys {
+
+
+// Load counter of a pool worker.
+// The counters live in a page shared by the master and all the workers so
+// the master can read the load of every worker without communicating.
+// Each counter is written by exactly one worker, hence the updates need no
+// atomic read-modify-write instruction.
+//
+class alignas(64) WorkerLoad
+{
+	std::atomic<uint64_t>  _value;
+
+	static_assert (std::atomic<uint64_t>::is_always_lock_free);
+
+
+ public:
+	void add(uint64_t n = 1) noexcept
+	{
+		_value.store(_value.load(std::memory_order_relaxed) + n,
+			     std::memory_order_relaxed);
+	}
+
+	void sub(uint64_t n = 1) noexcept
+	{
+		_value.store(_value.load(std::memory_order_relaxed) - n,
+			     std::memory_order_relaxed);
+	}
+
+	void reset(uint64_t n = 0) noexcept
+	{
+		_value.store(n, std::memory_order_relaxed);
+	}
+
+	uint64_t value() const noexcept
+	{
+		return _value.load(std::memory_order_relaxed);
+	}
+};
+
+
+// Prefork pool of worker processes.
+// Every worker runs `routine(index, load)` in a forked child and exits with
+// the value returned by the routine (or 0 if it returns nothing).
+// Resources opened before `start()`, typically a bound `TcpServerSocket`,
+// are inherited by all the workers.
+// The pool does not hand work to the workers: they accept it themselves,
+// from the inherited listener for instance. `load()` and `leastloaded()`
+// only tell the master which worker to pick when it dispatches work
+// through a channel of its own, like a pipe per worker.
+//
+template<typename Routine>
+requires std::invocable<Routine &, size_t, WorkerLoad &>
+class ProcessPool
+{
+ public:
+	using Worker = Process<ProcessBehavior::SUBPROCESS()>;
+
+
+ private:
+	Routine              _routine;
+	std::vector<Worker>  _workers;
+	WorkerLoad          *_loads;
+
+
+	static size_t _mapsize(size_t size) noexcept
+	{
+		return (size * sizeof (WorkerLoad));
+	}
+
+	[[noreturn]]
+	void _run(size_t index) noexcept
+	{
+		int code = EXIT_SUCCESS;
+
+#ifdef __cpp_exceptions
+		try {
+#endif
+			using Ret = std::invoke_result_t<Routine &, size_t,
+							 WorkerLoad &>;
+
+			if constexpr (std::convertible_to<Ret, int>) {
+				code = std::invoke(_routine, index,
+						   _loads[index]);
+			} else {
+				std::invoke(_routine, index, _loads[index]);
+			}
+#ifdef __cpp_exceptions
+		} catch (...) {
+			code = EXIT_FAILURE;
+		}
+#endif
+
+		// Never return nor unwind in the child: destroying the pool
+		// here would signal the siblings of this worker.
+		::_exit(code);
+	}
+
+	// Wait for `worker` to terminate, again if a signal interrupts the
+	// wait, so no zombie is left behind.
+	//
+	static pid_t _reap(Worker &worker) noexcept
+	{
+		pid_t ret;
+
+		do {
+			ret = worker.wait([](pid_t r) { return r; });
+		} while ((ret < 0) && (errno == EINTR));
+
+		return ret;
+	}
+
+	pid_t _spawn(size_t index) noexcept
+	{
+		Worker &worker = _workers[index];
+		pid_t pid;
+
+		assert(worker.valid() == false);
+
+		_loads[index].reset();
+
+		pid = worker.fork([](pid_t ret) { return ret; });
+
+		if (pid == 0)
+			_run(index);
+
+		if (pid < 0) [[unlikely]]
+			worker.reset();
+
+		return pid;
+	}
+
+
+ public:
+	explicit ProcessPool(Routine routine)
+		: _routine(std::move(routine)), _loads(nullptr)
+	{
+	}
+
+	ProcessPool(const ProcessPool &other) = delete;
+
+	ProcessPool(ProcessPool &&other) noexcept
+		: _routine(std::move(other._routine))
+		, _workers(std::move(other._workers))
+		, _loads(other._loads)
+	{
+		other._loads = nullptr;
+	}
+
+	~ProcessPool()
+	{
+		if (valid())
+			stop();
+	}
+
+	ProcessPool &operator=(const ProcessPool &other) = delete;
+	ProcessPool &operator=(ProcessPool &&other) = delete;
+
+
+	bool valid() const noexcept
+	{
+		return (_loads != nullptr);
+	}
+
+	size_t size() const noexcept
+	{
+		return _workers.size();
+	}
+
+	const Worker &worker(size_t index) const noexcept
+	{
+		assert(index < size());
+
+		return _workers[index];
+	}
+
+	uint64_t load(size_t index) const noexcept
+	{
+		assert(index < size());
+
+		return _loads[index].value();
+	}
+
+	size_t leastloaded() const noexcept
+	{
+		size_t i, best = 0;
+		uint64_t cur, min;
+
+		assert(size() > 0);
+
+		min = _loads[0].value();
+
+		for (i = 1; i < size(); i++) {
+			if ((cur = _loads[i].value()) < min) {
+				min = cur;
+				best = i;
+			}
+		}
+
+		return best;
+	}
+
+
+	template<typename ErrHandler>
+	auto start(size_t size, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		void *addr;
+		size_t i;
+
+		assert(valid() == false);
+		assert(size > 0);
+
+		addr = ::mmap(nullptr, _mapsize(size), PROT_READ | PROT_WRITE,
+			      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+		if (addr == MAP_FAILED) [[unlikely]]
+			return handler(-1);
+
+		_loads = static_cast<WorkerLoad *> (addr);
+		_workers.resize(size);
+
+		for (i = 0; i < size; i++)
+			if (_spawn(i) < 0) [[unlikely]]
+				return handler(-1);
+
+		return handler(0);
+	}
+
+	void start(size_t size)
+	{
+		start(size, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwstart();
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwstart()
+	{
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
+
+
+	// Reap the workers which have exited and fork a replacement for
+	// each of them.
+	// This never blocks so it can be called from the master event loop,
+	// for instance each time a `SIGCHLD` is notified.
+	// The handler receives the number of respawned workers or -1.
+	//
+	template<typename ErrHandler>
+	auto respawn(ErrHandler &&handler) noexcept (noexcept (handler(-1)))
+	{
+		int count = 0;
+		size_t i;
+		pid_t ret;
+
+		assert(valid());
+
+		for (i = 0; i < size(); i++) {
+			if (_workers[i].valid()) {
+				ret = _workers[i].wait(nullptr, WNOHANG,
+						       [](pid_t r) {
+					return r;
+				});
+
+				if (ret == 0)
+					continue;
+
+				if ((ret < 0) && (errno != ECHILD)) [[unlikely]]
+					return handler(-1);
+
+				_workers[i].reset();
+			}
+
+			if (_spawn(i) < 0) [[unlikely]]
+				return handler(-1);
+
+			count += 1;
+		}
+
+		return handler(count);
+	}
+
+	size_t respawn()
+	{
+		return respawn([](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwrespawn();
+			return static_cast<size_t> (ret);
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwrespawn()
+	{
+		SystemException::throwErrno();
+	}
+
+
+	// Gracefully replace the worker at `index`: send it `sig`, wait for
+	// its termination and fork a new one.
+	//
+	template<typename ErrHandler>
+	auto restart(size_t index, int sig, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		Worker &worker = _workers[index];
+
+		assert(valid());
+		assert(index < size());
+
+		if (worker.valid()) {
+			worker.kill(sig, [](int) {});
+
+			if (_reap(worker) < 0)
+				if (errno != ECHILD) [[unlikely]]
+					return handler(-1);
+
+			worker.reset();
+		}
+
+		return handler((_spawn(index) < 0) ? -1 : 0);
+	}
+
+	void restart(size_t index, int sig = SIGTERM)
+	{
+		restart(index, sig, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwrestart();
+		});
+	}
+
+	// Restart all the workers one after the other so that at most one
+	// worker is unavailable at any time.
+	//
+	template<typename ErrHandler>
+	auto restartall(int sig, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		auto passthrough = [](int r) { return r; };
+		size_t i;
+
+		for (i = 0; i < size(); i++)
+			if (restart(i, sig, passthrough) < 0) [[unlikely]]
+				return handler(-1);
+
+		return handler(0);
+	}
+
+	void restartall(int sig = SIGTERM)
+	{
+		restartall(sig, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwrestart();
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwrestart()
+	{
+		SystemException::throwErrno();
+	}
+
+
+	// Terminate all the workers: signal them all first, then wait for
+	// each of them, so the pool shuts down in the time of the slowest
+	// worker.
+	//
+	void stop(int sig = SIGTERM) noexcept
+	{
+		[[maybe_unused]] int ret;
+
+		assert(valid());
+
+		for (Worker &worker : _workers)
+			if (worker.valid())
+				worker.kill(sig, [](int) {});
+
+		for (Worker &worker : _workers) {
+			if (worker.valid()) {
+				_reap(worker);
+				worker.reset();
+			}
+		}
+
+		ret = ::munmap(_loads, _mapsize(size()));
+		assert(ret == 0);
+
+		_workers.clear();
+		_loads = nullptr;
+	}
+};
+
+
+}
+
+
+#endif
@@ -25,8 +25,10 @@
 #include <cerrno>
 
 #include <pthread.h>
+#include <time.h>
 
 #include <concepts>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <type_traits>
@@ -615,6 +617,7 @@ class Pthread
 
 	// ====================================================================
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void createthrow(int ret)
 	{
 		assert(ret != EINVAL);
@@ -718,6 +721,83 @@ class Pthread
 	{
 		assert(ret != ESRCH);
 	}
+
+
+	// CPU time consumed by the thread so far, in nanoseconds.
+	// The thread must not be joined yet but may have exited, in which
+	// case the handler receives `EINVAL`.
+	//
+	template<typename ErrHandler>
+	auto cputime(uint64_t *dest, ErrHandler &&handler) const
+		noexcept (noexcept (handler(-1)))
+	{
+		struct timespec ts;
+		clockid_t clock;
+		int ret;
+
+		assert(valid());
+
+		ret = ::pthread_getcpuclockid(_tid, &clock);
+
+		if (ret == 0) [[likely]] {
+			if (::clock_gettime(clock, &ts) == 0) [[likely]]
+				*dest = ts.tv_sec * 1000000000ul + ts.tv_nsec;
+			else
+				ret = errno;
+		}
+
+		return handler(ret);
+	}
+
+	uint64_t cputime() const
+	{
+		uint64_t ret;
+
+		cputime(&ret, [](int err) {
+			if (err != 0) [[unlikely]]
+				cputimethrow(err);
+		});
+
+		return ret;
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void cputimethrow(int ret)
+	{
+		assert(ret != ENOENT);
+
+		SystemException::throwErrno(ret);
+	}
+
+
+	// Set the name of the thread as shown in `/proc/<pid>/task/<tid>/comm`
+	// and by debuggers.
+	// The name is at most 15 characters long, longer names fail with
+	// `ERANGE`.
+	//
+	template<typename ErrHandler>
+	auto setname(const char *name, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+		assert(name != nullptr);
+
+		return handler(::pthread_setname_np(_tid, name));
+	}
+
+	void setname(const char *name)
+	{
+		setname(name, [](int ret) {
+			if (ret != 0) [[unlikely]]
+				setnamethrow(ret);
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void setnamethrow(int ret)
+	{
+		SystemException::throwErrno(ret);
+	}
 };
 
 
@@ -56,6 +56,7 @@ class PthreadMutex
 	PthreadMutex &operator=(const PthreadMutex &) = delete;
 	PthreadMutex &operator=(PthreadMutex &&) = delete;
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void initthrow(int err)
 	{
 		assert(err != EINVAL);
@@ -0,0 +1,61 @@
+#ifndef _INCLUDE_METASYS_SCHED_PTHREADREGISTRY_HXX_
+#define _INCLUDE_METASYS_SCHED_PTHREADREGISTRY_HXX_
+
+
+#include <pthread.h>
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace metasys {
+
+
+// State of a listed thread at the time of a `PthreadRegistry::snapshot()`.
+//
+struct PthreadSample
+{
+	pthread_t  thread;
+	pid_t      tid;        // kernel thread id, as in `/proc/<pid>/task`
+	char       name[16];   // name given when enlisting
+	uint64_t   cputime;    // nanoseconds, 0 if the clock is unreadable
+};
+
+
+// Process wide list of the threads whose activity is exported.
+// A thread enlists itself and stays listed until it delists or exits.
+// Creating a `Pthread` does not enlist it so that `create()` stays a plain
+// `pthread_create()`: the threads spawned by metasys itself enlist from
+// their routine and the application decides for its own threads.
+//
+struct PthreadRegistry
+{
+	// Add the calling thread to the registry and name it `name` if not
+	// null, truncated to 15 characters.
+	// Enlisting an already listed thread only renames it.
+	//
+	static void enlist(const char *name = nullptr) noexcept;
+
+	static void delist() noexcept;
+
+	static bool listed() noexcept;
+
+
+	// Sample the listed threads in `dest` and return how many threads
+	// are listed, which may be more than `dest.size()`.
+	// This takes one `clock_gettime()` per sampled thread, the other
+	// fields being cached at enlisting time.
+	//
+	static size_t snapshot(std::span<PthreadSample> dest) noexcept;
+
+	static std::vector<PthreadSample> snapshot();
+};
+
+
+}
+
+
+#endif
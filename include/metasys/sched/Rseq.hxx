@@ -0,0 +1,223 @@
+#ifndef _INCLUDE_METASYS_SCHED_RSEQ_HXX_
+#define _INCLUDE_METASYS_SCHED_RSEQ_HXX_
+
+
+#include <sys/rseq.h>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace metasys {
+
+
+namespace detail {
+
+
+struct rseq *rseqarea() noexcept;
+
+
+}
+
+
+// Restartable sequences of the calling thread.
+// A restartable sequence is a short piece of code ending with a single
+// commit instruction which the kernel aborts if the thread is preempted,
+// migrated or interrupted by a signal before the commit. Per CPU data can
+// then be updated with plain loads and stores instead of atomic
+// read-modify-write instructions.
+// The `try*()` functions run one sequence on the slot of `cpu`, which must
+// be the `cpu()` read just before, and return `false` if the sequence was
+// aborted, in which case the caller reads `cpu()` again and retries.
+// Only x86-64 is supported, elsewhere `area()` is always null.
+//
+struct Rseq
+{
+	// Registration area of the calling thread, or null if restartable
+	// sequences are not available.
+	// The area registered by glibc is used when there is one, otherwise
+	// the thread registers its own on its first call.
+	//
+	static struct rseq *area() noexcept
+	{
+#if defined(__x86_64__)
+		char *tp = static_cast<char *> (__builtin_thread_pointer());
+		struct rseq *ret;
+
+		if (__rseq_size > 0) [[likely]] {
+			ret = reinterpret_cast<struct rseq *>
+				(tp + __rseq_offset);
+
+			// glibc leaves this cpu id in the area of the threads
+			// it failed to register.
+			if (ret->cpu_id == static_cast<uint32_t>
+			    (RSEQ_CPU_ID_REGISTRATION_FAILED)) [[unlikely]]
+				return nullptr;
+
+			return ret;
+		}
+
+		return detail::rseqarea();
+#else
+		return nullptr;
+#endif
+	}
+
+	// Whether the process uses restartable sequences, decided once by
+	// the first thread to ask, from whether it has an `area()`.
+	// A thread may still have no area when they are enabled, if its own
+	// registration failed. The plain stores of a sequence do not mix with
+	// atomic instructions or locks from another CPU, so such a thread
+	// must keep away from the data the others update in sequences.
+	//
+	static bool enabled() noexcept
+	{
+		static const bool ret = (area() != nullptr);
+
+		return ret;
+	}
+
+	// CPU the thread runs on according to `area`, always lower than
+	// `PerCpu<T>::cpus()`.
+	//
+	static uint32_t cpu(const struct rseq *area) noexcept
+	{
+		return *static_cast<const volatile uint32_t *>
+			(&area->cpu_id_start);
+	}
+
+
+#if defined(__x86_64__)
+	static_assert (RSEQ_SIG == 0x53053053);
+
+// Descriptor of the sequence starting at `1:`, committing right before `2:`
+// and aborting to `4:`, which is preceded by the signature the kernel
+// checks before jumping there.
+// The descriptor is then published in the `rseq_cs` field of the area and
+// the sequence aborts right away if the thread is not on `cpu` anymore.
+//
+#define __METASYS_RSEQ_ENTER                                               \
+		".pushsection __rseq_cs, \"aw\"\n\t"                       \
+		".balign 32\n\t"                                           \
+		"3:\n\t"                                                   \
+		".long 0x0, 0x0\n\t"                                       \
+		".quad 1f, (2f - 1f), 4f\n\t"                              \
+		".popsection\n\t"                                          \
+		".pushsection __rseq_failure, \"ax\"\n\t"                  \
+		".byte 0x0f, 0xb9, 0x3d\n\t"                               \
+		".long 0x53053053\n\t"                                     \
+		"4:\n\t"                                                   \
+		"jmp %l[abort]\n\t"                                        \
+		".popsection\n\t"                                          \
+		"leaq 3b(%%rip), %%rax\n\t"                                \
+		"movq %%rax, %[rseq_cs]\n\t"                               \
+		"1:\n\t"                                                   \
+		"cmpl %[cpu], %[cpu_id]\n\t"                               \
+		"jnz 4b\n\t"
+
+#define __METASYS_RSEQ_OPERANDS(area, cpu)                                 \
+		[rseq_cs] "m" ((area)->rseq_cs),                           \
+		[cpu_id] "m" ((area)->cpu_id),                             \
+		[cpu] "r" (cpu)
+
+
+	// Add `n` to `*dest`.
+	//
+	[[gnu::always_inline]]
+	static bool tryadd(struct rseq *area, uint32_t cpu, uint64_t *dest,
+			   uint64_t n) noexcept
+	{
+		__asm__ __volatile__ goto (
+			__METASYS_RSEQ_ENTER
+			"addq %[n], %[dest]\n\t"
+			"2:\n\t"
+			:
+			: __METASYS_RSEQ_OPERANDS(area, cpu),
+			  [dest] "m" (*dest), [n] "er" (n)
+			: "memory", "cc", "rax"
+			: abort);
+
+		return true;
+	 abort:
+		return false;
+	}
+
+	// Push `node` on the list at `*head`, linking through the first word
+	// of the node.
+	//
+	[[gnu::always_inline]]
+	static bool trypush(struct rseq *area, uint32_t cpu, void **head,
+			    void *node) noexcept
+	{
+		__asm__ __volatile__ goto (
+			__METASYS_RSEQ_ENTER
+			"movq %[head], %%rcx\n\t"
+			"movq %%rcx, (%[node])\n\t"
+			"movq %[node], %[head]\n\t"
+			"2:\n\t"
+			:
+			: __METASYS_RSEQ_OPERANDS(area, cpu),
+			  [head] "m" (*head), [node] "r" (node)
+			: "memory", "cc", "rax", "rcx"
+			: abort);
+
+		return true;
+	 abort:
+		return false;
+	}
+
+	// Pop the first node of the list at `*head` in `*dest`, or set it to
+	// null if the list is empty.
+	//
+	[[gnu::always_inline]]
+	static bool trypop(struct rseq *area, uint32_t cpu, void **head,
+			   void **dest) noexcept
+	{
+		__asm__ __volatile__ goto (
+			__METASYS_RSEQ_ENTER
+			"movq %[head], %%rcx\n\t"
+			"movq %%rcx, %[dest]\n\t"
+			"testq %%rcx, %%rcx\n\t"
+			"jz 2f\n\t"
+			"movq (%%rcx), %%rcx\n\t"
+			"movq %%rcx, %[head]\n\t"
+			"2:\n\t"
+			:
+			: __METASYS_RSEQ_OPERANDS(area, cpu),
+			  [head] "m" (*head), [dest] "m" (*dest)
+			: "memory", "cc", "rax", "rcx"
+			: abort);
+
+		return true;
+	 abort:
+		return false;
+	}
+
+#undef __METASYS_RSEQ_OPERANDS
+#undef __METASYS_RSEQ_ENTER
+#else
+	static bool tryadd(struct rseq *, uint32_t, uint64_t *, uint64_t)
+		noexcept
+	{
+		return false;
+	}
+
+	static bool trypush(struct rseq *, uint32_t, void **, void *)
+		noexcept
+	{
+		return false;
+	}
+
+	static bool trypop(struct rseq *, uint32_t, void **, void **)
+		noexcept
+	{
+		return false;
+	}
+#endif
+};
+
+
+}
+
+
+#endif
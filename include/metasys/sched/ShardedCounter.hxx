@@ -0,0 +1,175 @@
+#ifndef _INCLUDE_METASYS_SCHED_SHARDEDCOUNTER_HXX_
+#define _INCLUDE_METASYS_SCHED_SHARDEDCOUNTER_HXX_
+
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <metasys/sched/PerCpu.hxx>
+#include <metasys/sched/Rseq.hxx>
+
+
+namespace metasys {
+
+
+namespace detail {
+
+
+// Add `n` to the counter `select(shard)` of the shard of the current CPU.
+// This is a restartable sequence when the process uses them and every CPU
+// has its own shard, and an atomic instruction otherwise.
+// The two are never mixed on a same shard: a thread which cannot run a
+// sequence while the others do adds to `shared` instead.
+//
+template<typename Shard, typename Select>
+void shardadd(PerCpu<Shard> &shards, Shard &shared, Select &&select,
+	      uint64_t n) noexcept
+{
+	struct rseq *area;
+	std::atomic<uint64_t> *dest;
+	uint32_t cpu;
+
+	static_assert (sizeof (std::atomic<uint64_t>) == sizeof (uint64_t));
+
+	if ((Rseq::enabled() == false) || (shards.complete() == false))
+	    [[unlikely]] {
+		select(shards.local()).fetch_add(n, std::memory_order_relaxed);
+		return;
+	}
+
+	area = Rseq::area();
+
+	while (area != nullptr) {
+		cpu = Rseq::cpu(area);
+
+		if (cpu >= shards.size()) [[unlikely]]
+			break;
+
+		dest = &select(shards[cpu]);
+
+		if (Rseq::tryadd(area, cpu, reinterpret_cast<uint64_t *> (dest),
+				 n))
+			return;
+	}
+
+	select(shared).fetch_add(n, std::memory_order_relaxed);
+}
+
+
+}
+
+
+// Counter split in one shard per CPU.
+// Updates only touch the shard of the current CPU, with a restartable
+// sequence instead of an atomic instruction where available, and reads sum
+// all the shards without locking, so a read concurrent with updates may miss
+// the most recent ones but never sees a partial update.
+//
+class ShardedCounter
+{
+	PerCpu<std::atomic<uint64_t>>  _shards;
+	std::atomic<uint64_t>          _shared = 0;
+
+
+ public:
+	ShardedCounter() = default;
+
+	explicit ShardedCounter(size_t ncpus)
+		: _shards(ncpus)
+	{
+	}
+
+
+	void add(uint64_t n = 1) noexcept
+	{
+		detail::shardadd(_shards, _shared, [](auto &shard) -> auto & {
+			return shard;
+		}, n);
+	}
+
+	uint64_t load() const noexcept
+	{
+		uint64_t ret = _shared.load(std::memory_order_relaxed);
+		size_t i;
+
+		for (i = 0; i < _shards.size(); i++)
+			ret += _shards[i].load(std::memory_order_relaxed);
+
+		return ret;
+	}
+};
+
+
+// Histogram of `N` buckets split in one shard per CPU, with the same
+// guarantees as `ShardedCounter`.
+// Choosing the bucket of a sample is left to the caller, for instance with
+// `TraceStats::bucket()` for durations.
+//
+template<size_t N>
+class ShardedHistogram
+{
+	PerCpu<std::array<std::atomic<uint64_t>, N>>  _shards;
+	std::array<std::atomic<uint64_t>, N>          _shared = {};
+
+
+ public:
+	static constexpr size_t BUCKETS = N;
+
+
+	ShardedHistogram() = default;
+
+	explicit ShardedHistogram(size_t ncpus)
+		: _shards(ncpus)
+	{
+	}
+
+
+	void add(size_t bucket, uint64_t n = 1) noexcept
+	{
+		assert(bucket < N);
+
+		detail::shardadd(_shards, _shared,
+				 [bucket](auto &shard) -> auto & {
+			return shard[bucket];
+		}, n);
+	}
+
+	uint64_t load(size_t bucket) const noexcept
+	{
+		uint64_t ret = _shared[bucket].load(std::memory_order_relaxed);
+		size_t i;
+
+		assert(bucket < N);
+
+		for (i = 0; i < _shards.size(); i++)
+			ret += _shards[i][bucket].load
+				(std::memory_order_relaxed);
+
+		return ret;
+	}
+
+	std::array<uint64_t, N> load() const noexcept
+	{
+		std::array<uint64_t, N> ret = {};
+		size_t i, b;
+
+		for (b = 0; b < N; b++)
+			ret[b] = _shared[b].load(std::memory_order_relaxed);
+
+		for (i = 0; i < _shards.size(); i++)
+			for (b = 0; b < N; b++)
+				ret[b] += _shards[i][b].load
+					(std::memory_order_relaxed);
+
+		return ret;
+	}
+};
+
+
+}
+
+
+#endif
@@ -22,13 +22,34 @@
 
 
 #include <pthread.h>
+#include <sys/resource.h>
+#include <time.h>
 
 #include <cassert>
+#include <cerrno>
+#include <cstdint>
+
+#include <metasys/sys/SystemException.hxx>
 
 
 namespace metasys {
 
 
+// Resources used by a thread as reported by `getrusage(RUSAGE_THREAD)`.
+//
+struct PthreadUsage
+{
+	uint64_t  usertime;             // nanoseconds in user mode
+	uint64_t  systemtime;           // nanoseconds in kernel mode
+	uint64_t  minorfaults;          // page faults served without I/O
+	uint64_t  majorfaults;          // page faults which needed I/O
+	uint64_t  voluntaryswitches;    // blocked waiting for a resource
+	uint64_t  involuntaryswitches;  // preempted by the scheduler
+	uint64_t  inblocks;             // blocks read from the filesystem
+	uint64_t  outblocks;            // blocks written to the filesystem
+};
+
+
 struct ThisPthread
 {
 	static void testcancel()
@@ -55,6 +76,95 @@ struct ThisPthread
 		else
 			return false;
 	}
+
+
+	// CPU time consumed by the calling thread so far, in nanoseconds.
+	// This is served by the vDSO and does not enter the kernel.
+	//
+	static uint64_t cputime() noexcept
+	{
+		struct timespec ts;
+		int ret [[maybe_unused]];
+
+		ret = ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+		assert(ret == 0);
+
+		return ts.tv_sec * 1000000000ul + ts.tv_nsec;
+	}
+
+
+	template<typename ErrHandler>
+	static auto usage(PthreadUsage *dest, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		struct rusage ru;
+		int ret;
+
+		ret = ::getrusage(RUSAGE_THREAD, &ru);
+
+		if (ret == 0) [[likely]] {
+			dest->usertime = ru.ru_utime.tv_sec * 1000000000ul
+				+ ru.ru_utime.tv_usec * 1000ul;
+			dest->systemtime = ru.ru_stime.tv_sec * 1000000000ul
+				+ ru.ru_stime.tv_usec * 1000ul;
+			dest->minorfaults = ru.ru_minflt;
+			dest->majorfaults = ru.ru_majflt;
+			dest->voluntaryswitches = ru.ru_nvcsw;
+			dest->involuntaryswitches = ru.ru_nivcsw;
+			dest->inblocks = ru.ru_inblock;
+			dest->outblocks = ru.ru_oublock;
+		}
+
+		return handler(ret);
+	}
+
+	static PthreadUsage usage()
+	{
+		PthreadUsage ret;
+
+		usage(&ret, [](int err) {
+			if (err != 0) [[unlikely]]
+				usagethrow();
+		});
+
+		return ret;
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void usagethrow()
+	{
+		assert(errno != EFAULT);
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
+
+
+	// Set the name of the calling thread, at most 15 characters long.
+	//
+	template<typename ErrHandler>
+	static auto setname(const char *name, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(name != nullptr);
+
+		return handler(::pthread_setname_np(::pthread_self(), name));
+	}
+
+	static void setname(const char *name)
+	{
+		setname(name, [](int ret) {
+			if (ret != 0) [[unlikely]]
+				setnamethrow(ret);
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void setnamethrow(int ret)
+	{
+		SystemException::throwErrno(ret);
+	}
 };
 
 
@@ -0,0 +1,172 @@
+#ifndef _INCLUDE_METASYS_SCHED_THREADLOCAL_HXX_
+#define _INCLUDE_METASYS_SCHED_THREADLOCAL_HXX_
+
+
+#include <pthread.h>
+
+#include <cassert>
+#include <cerrno>
+#include <new>
+
+#include <metasys/sched/PthreadMutex.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+namespace metasys {
+
+
+// One `T` per thread, default constructed on the first access from each
+// thread.
+// The instance of a thread is destroyed when the thread exits, hence before
+// `Pthread::join()` returns, and the instances left, such as the one of the
+// main thread, are destroyed along with the `ThreadLocal`.
+// Unlike `thread_local` variables, a `ThreadLocal` can be a member of an
+// object and `foreach()` visits the instances of all the threads, e.g. to
+// aggregate per thread statistics.
+// The `ThreadLocal` must not be destroyed while other threads use it.
+//
+template<typename T>
+class ThreadLocal
+{
+	struct Node
+	{
+		T             value;
+		ThreadLocal  *owner;
+		Node         *prev;
+		Node         *next;
+	};
+
+
+	pthread_key_t  _key;
+	PthreadMutex   _lock;
+	Node          *_nodes;
+
+
+	void _unlink(Node *node) noexcept
+	{
+		if (node->prev != nullptr)
+			node->prev->next = node->next;
+		else
+			_nodes = node->next;
+		if (node->next != nullptr)
+			node->next->prev = node->prev;
+	}
+
+	static void _destroy(void *ptr) noexcept
+	{
+		Node *node = static_cast<Node *> (ptr);
+		ThreadLocal *owner = node->owner;
+
+		owner->_lock.lock();
+		owner->_unlink(node);
+		owner->_lock.unlock();
+
+		delete node;
+	}
+
+	[[gnu::noinline]]
+	Node *_create()
+	{
+		Node *node = new Node { T(), this, nullptr, nullptr };
+		int ret;
+
+		ret = ::pthread_setspecific(_key, node);
+
+		if (ret != 0) [[unlikely]] {
+			delete node;
+			keythrow(ret);
+		}
+
+		_lock.lock();
+
+		node->next = _nodes;
+		if (_nodes != nullptr)
+			_nodes->prev = node;
+		_nodes = node;
+
+		_lock.unlock();
+
+		return node;
+	}
+
+
+ public:
+	ThreadLocal()
+		: _nodes(nullptr)
+	{
+		int ret = ::pthread_key_create(&_key, _destroy);
+
+		if (ret != 0) [[unlikely]]
+			keythrow(ret);
+	}
+
+	ThreadLocal(const ThreadLocal &other) = delete;
+	ThreadLocal(ThreadLocal &&other) = delete;
+
+	~ThreadLocal()
+	{
+		Node *node;
+
+		::pthread_key_delete(_key);
+
+		while ((node = _nodes) != nullptr) {
+			_nodes = node->next;
+			delete node;
+		}
+	}
+
+	ThreadLocal &operator=(const ThreadLocal &other) = delete;
+	ThreadLocal &operator=(ThreadLocal &&other) = delete;
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void keythrow(int ret)
+	{
+		SystemException::throwErrno(ret);
+	}
+
+
+	T &get()
+	{
+		Node *node = static_cast<Node *> (::pthread_getspecific(_key));
+
+		if (node == nullptr) [[unlikely]]
+			node = _create();
+
+		return node->value;
+	}
+
+	T &operator*()
+	{
+		return get();
+	}
+
+	T *operator->()
+	{
+		return &get();
+	}
+
+
+	// Call `visitor(value)` for the instance of every thread which
+	// accessed this `ThreadLocal` and has not exited yet.
+	// Threads exiting or making their first access meanwhile wait for
+	// the visit to complete, so `visitor` must not throw.
+	//
+	template<typename Visitor>
+	void foreach(Visitor &&visitor)
+	{
+		Node *node;
+
+		_lock.lock();
+
+		for (node = _nodes; node != nullptr; node = node->next)
+			visitor(node->value);
+
+		_lock.unlock();
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef _INCLUDE_METASYS_SYS_ARENA_HXX_
+#define _INCLUDE_METASYS_SYS_ARENA_HXX_
+
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+
+namespace metasys {
+
+
+// Bump allocator over an in-object buffer of `N` bytes.
+// Allocations are released all at once by `reset()` or when the arena is
+// destroyed, typically along with the per-connection state embedding it.
+// Objects created in the arena are not destroyed: only use it for
+// trivially destructible types or destroy them explicitly.
+//
+template<size_t N>
+class Arena
+{
+	size_t     _used;
+	alignas(std::max_align_t)
+	std::byte  _buf[N];
+
+
+ public:
+	constexpr Arena() noexcept
+		: _used(0)
+	{
+	}
+
+	Arena(const Arena &other) = delete;
+	Arena &operator=(const Arena &other) = delete;
+
+
+	static constexpr size_t capacity() noexcept
+	{
+		return N;
+	}
+
+	size_t used() const noexcept
+	{
+		return _used;
+	}
+
+	// Return `len` bytes aligned on `align` or `nullptr` if the arena is
+	// exhausted.
+	//
+	void *allocate(size_t len, size_t align = alignof (std::max_align_t))
+		noexcept
+	{
+		uintptr_t addr = reinterpret_cast<uintptr_t> (_buf + _used);
+		size_t start;
+
+		assert((align & (align - 1)) == 0);
+
+		// Align the address rather than the offset: the buffer itself
+		// is only aligned on `std::max_align_t`.
+		start = _used + (((addr + align - 1) & ~(align - 1)) - addr);
+
+		if ((start > N) || (len > (N - start))) [[unlikely]]
+			return nullptr;
+
+		_used = start + len;
+
+		return (_buf + start);
+	}
+
+	template<typename T, typename ... Args>
+	T *create(Args && ... args)
+	{
+		void *ptr = allocate(sizeof (T), alignof (T));
+
+		if (ptr == nullptr) [[unlikely]]
+			return nullptr;
+
+		return std::construct_at(static_cast<T *> (ptr),
+					 std::forward<Args>(args) ...);
+	}
+
+	void reset() noexcept
+	{
+		_used = 0;
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef _INCLUDE_METASYS_SYS_CPUFEATURES_HXX_
+#define _INCLUDE_METASYS_SYS_CPUFEATURES_HXX_
+
+
+namespace metasys {
+
+
+namespace detail {
+
+
+// Instruction set extensions of the running CPU used by the library to
+// select its vectorized implementations.
+// All are false on other architectures than x86-64.
+//
+struct CpuFeatures
+{
+	bool  sse2;
+	bool  ssse3;
+	bool  avx2;
+};
+
+// Probe the running CPU.
+// Safe to call from static initializers, which may run before the libgcc
+// constructor that usually does the probing.
+//
+inline CpuFeatures cpufeatures() noexcept
+{
+	CpuFeatures ret = {};
+
+#if defined(__x86_64__)
+	__builtin_cpu_init();
+
+	ret.sse2 = __builtin_cpu_supports("sse2");
+	ret.ssse3 = __builtin_cpu_supports("ssse3");
+	ret.avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+	return ret;
+}
+
+
+}
+
+
+}
+
+
+#endif
@@ -112,6 +112,7 @@ class FileDescriptor
 		});
 	}
 
+	[[noreturn, gnu::cold, gnu::noinline]]
 	static void closethrow()
 	{
 		assert(errno != EBADF);
@@ -0,0 +1,320 @@
+#ifndef _INCLUDE_METASYS_SYS_MEMORYMAPPING_HXX_
+#define _INCLUDE_METASYS_SYS_MEMORYMAPPING_HXX_
+
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <span>
+
+#include <metasys/sys/FileDescriptor.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+namespace metasys {
+
+
+// Owner of a memory region obtained with `mmap()`.
+// The region is unmapped on destruction.
+// Mapping a file gives zero-copy access to its content through `data()` or
+// `span<T>()`, the kernel is told about the access pattern with `advise()`.
+//
+class MemoryMapping
+{
+	void    *_addr;
+	size_t   _len;
+
+
+ public:
+	static constexpr int POPULATE   = MAP_POPULATE;
+
+	static constexpr int NORMAL     = MADV_NORMAL;
+	static constexpr int SEQUENTIAL = MADV_SEQUENTIAL;
+	static constexpr int RANDOM     = MADV_RANDOM;
+	static constexpr int WILLNEED   = MADV_WILLNEED;
+	static constexpr int DONTNEED   = MADV_DONTNEED;
+	static constexpr int HUGEPAGE   = MADV_HUGEPAGE;
+
+
+	constexpr MemoryMapping() noexcept
+		: _addr(nullptr), _len(0)
+	{
+	}
+
+	constexpr MemoryMapping(void *addr, size_t len) noexcept
+		: _addr(addr), _len(len)
+	{
+	}
+
+	MemoryMapping(const MemoryMapping &other) = delete;
+	MemoryMapping(MemoryMapping &&other) noexcept;
+
+	~MemoryMapping() noexcept
+	{
+		if (valid())
+			unmap();
+	}
+
+	MemoryMapping &operator=(const MemoryMapping &other) = delete;
+	MemoryMapping &operator=(MemoryMapping &&other) noexcept;
+
+
+	constexpr void *data() const noexcept
+	{
+		return _addr;
+	}
+
+	constexpr size_t size() const noexcept
+	{
+		return _len;
+	}
+
+	constexpr bool valid() const noexcept
+	{
+		return (_addr != nullptr);
+	}
+
+	// View the mapping as an array of `T`.
+	// A trailing part smaller than `sizeof (T)` is not part of the span.
+	//
+	template<typename T>
+	std::span<T> span() const noexcept
+	{
+		return std::span<T>(static_cast<T *> (_addr),
+				    _len / sizeof (T));
+	}
+
+	void *reset(void *addr = nullptr, size_t len = 0) noexcept;
+
+
+	// Map `len` bytes of `fd` from `offset`, or anonymous memory if `fd`
+	// is -1.
+	// The handler receives the mapped address or `MAP_FAILED`.
+	//
+	template<typename ErrHandler>
+	auto map(size_t len, int prot, int flags, int fd, off_t offset,
+		 ErrHandler &&handler)
+		noexcept (noexcept (handler(MAP_FAILED)))
+	{
+		void *addr;
+
+		assert(valid() == false);
+
+		addr = ::mmap(nullptr, len, prot, flags, fd, offset);
+
+		if (addr != MAP_FAILED) [[likely]] {
+			_addr = addr;
+			_len = len;
+		}
+
+		return handler(addr);
+	}
+
+	template<typename ErrHandler>
+	auto map(size_t len, int prot, int flags, const FileDescriptor &fd,
+		 off_t offset, ErrHandler &&handler)
+		noexcept (noexcept (handler(MAP_FAILED)))
+	{
+		return map(len, prot, flags, fd.value(), offset,
+			   std::forward<ErrHandler>(handler));
+	}
+
+	// Map the whole content of the file `fd` as it is now.
+	//
+	template<typename ErrHandler>
+	auto map(const FileDescriptor &fd, int prot, int flags,
+		 ErrHandler &&handler)
+		noexcept (noexcept (handler(MAP_FAILED)))
+	{
+		struct stat st;
+
+		if (::fstat(fd.value(), &st) < 0) [[unlikely]]
+			return handler(MAP_FAILED);
+
+		return map(static_cast<size_t> (st.st_size), prot, flags,
+			   fd.value(), 0, std::forward<ErrHandler>(handler));
+	}
+
+	void map(size_t len, int prot, int flags, int fd = -1,
+		 off_t offset = 0)
+	{
+		map(len, prot, flags, fd, offset, [](void *ret) {
+			if (ret == MAP_FAILED) [[unlikely]]
+				throwmap();
+		});
+	}
+
+	void map(const FileDescriptor &fd, int prot = PROT_READ,
+		 int flags = MAP_SHARED)
+	{
+		map(fd, prot, flags, [](void *ret) {
+			if (ret == MAP_FAILED) [[unlikely]]
+				throwmap();
+		});
+	}
+
+	template<typename ... Args>
+	static MemoryMapping mapinit(Args && ... args)
+	{
+		MemoryMapping ret;
+
+		ret.map(std::forward<Args>(args) ...);
+
+		return ret;
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwmap()
+	{
+		assert(errno != EBADF);
+
+		SystemException::throwErrno();
+	}
+
+
+	void unmap() noexcept
+	{
+		[[maybe_unused]] int ret;
+
+		assert(valid());
+
+		ret = ::munmap(_addr, _len);
+
+		assert(ret == 0);  // Only EINVAL on a valid mapping
+
+		_addr = nullptr;
+		_len = 0;
+	}
+
+
+	template<typename ErrHandler>
+	auto advise(size_t offset, size_t len, int advice,
+		    ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+		assert((offset + len) <= _len);
+
+		return handler(::madvise(static_cast<char *> (_addr) + offset,
+					 len, advice));
+	}
+
+	template<typename ErrHandler>
+	auto advise(int advice, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return advise(0, _len, advice,
+			      std::forward<ErrHandler>(handler));
+	}
+
+	void advise(size_t offset, size_t len, int advice)
+	{
+		advise(offset, len, advice, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwadvise();
+		});
+	}
+
+	void advise(int advice)
+	{
+		advise(0, _len, advice);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwadvise()
+	{
+		assert(errno != EBADF);
+
+		SystemException::throwErrno();
+	}
+
+
+	// Grow or shrink the mapping to `len` bytes.
+	// With `MREMAP_MAYMOVE`, the kernel can move the mapping instead of
+	// failing when there is no room to grow in place. Pointers inside the
+	// mapping must then be rebuilt from `data()`.
+	//
+	template<typename ErrHandler>
+	auto remap(size_t len, int flags, ErrHandler &&handler)
+		noexcept (noexcept (handler(MAP_FAILED)))
+	{
+		void *addr;
+
+		assert(valid());
+
+		addr = ::mremap(_addr, _len, len, flags);
+
+		if (addr != MAP_FAILED) [[likely]] {
+			_addr = addr;
+			_len = len;
+		}
+
+		return handler(addr);
+	}
+
+	void remap(size_t len, int flags = MREMAP_MAYMOVE)
+	{
+		remap(len, flags, [](void *ret) {
+			if (ret == MAP_FAILED) [[unlikely]]
+				throwremap();
+		});
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwremap()
+	{
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
+
+
+	template<typename ErrHandler>
+	auto sync(size_t offset, size_t len, int flags, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		assert(valid());
+		assert((offset + len) <= _len);
+
+		return handler(::msync(static_cast<char *> (_addr) + offset,
+				       len, flags));
+	}
+
+	template<typename ErrHandler>
+	auto sync(int flags, ErrHandler &&handler)
+		noexcept (noexcept (handler(-1)))
+	{
+		return sync(0, _len, flags, std::forward<ErrHandler>(handler));
+	}
+
+	void sync(size_t offset, size_t len, int flags = MS_SYNC)
+	{
+		sync(offset, len, flags, [](int ret) {
+			if (ret < 0) [[unlikely]]
+				throwsync();
+		});
+	}
+
+	void sync(int flags = MS_SYNC)
+	{
+		sync(0, _len, flags);
+	}
+
+	[[noreturn, gnu::cold, gnu::noinline]]
+	static void throwsync()
+	{
+		assert(errno != EINVAL);
+
+		SystemException::throwErrno();
+	}
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef _INCLUDE_METASYS_SYS_RESULT_HXX_
+#define _INCLUDE_METASYS_SYS_RESULT_HXX_
+
+
+#include <cassert>
+#include <cerrno>
+#include <concepts>
+#include <cstdlib>
+#include <cstring>
+
+#include <metasys/sys/SystemException.hxx>
+
+
+namespace metasys {
+
+
+// Error code of a failed system call.
+//
+class Errno
+{
+	int  _value;
+
+
+ public:
+	constexpr explicit Errno(int value) noexcept
+		: _value(value)
+	{
+	}
+
+	static Errno current() noexcept
+	{
+		return Errno(errno);
+	}
+
+	constexpr int value() const noexcept
+	{
+		return _value;
+	}
+
+	const char *message() const noexcept
+	{
+		return ::strerror(_value);
+	}
+
+	constexpr bool operator==(const Errno &other) const noexcept = default;
+
+	constexpr bool operator==(int other) const noexcept
+	{
+		return (_value == other);
+	}
+
+	// Throw the `ErrnoException` matching this error, or abort when
+	// compiled without exceptions.
+	//
+	[[noreturn]]
+	void raise() const
+	{
+#ifdef __cpp_exceptions
+		SystemException::throwErrno(_value);
+#else
+		::abort();
+#endif
+	}
+};
+
+
+// Either the non negative result of a system call or the `Errno` of its
+// failure, in the fashion of `std::expected<T, Errno>`.
+// The error is stored as `-errno` in place of the value, like the kernel
+// does, so a `Result` is exactly as large as `T` and is returned in a single
+// register.
+//
+template<std::signed_integral T>
+class Result
+{
+	T  _value;
+
+
+	constexpr explicit Result(T value) noexcept
+		: _value(value)
+	{
+	}
+
+
+ public:
+	static constexpr Result success(T value) noexcept
+	{
+		assert(value >= 0);
+
+		return Result(value);
+	}
+
+	static constexpr Result failure(Errno error) noexcept
+	{
+		assert(error.value() > 0);
+
+		// Lets the compiler know that a failure is never mistaken for
+		// a value, so testing the result folds in the `ret < 0` test
+		// of the system call.
+		if (error.value() <= 0)
+			__builtin_unreachable();
+
+		return Result(static_cast<T> (-error.value()));
+	}
+
+	constexpr Result(const Result &other) noexcept = default;
+
+	constexpr Result &operator=(const Result &other) noexcept = default;
+
+
+	constexpr bool has_value() const noexcept
+	{
+		return (_value >= 0);
+	}
+
+	constexpr explicit operator bool() const noexcept
+	{
+		return has_value();
+	}
+
+	constexpr T operator*() const noexcept
+	{
+		assert(has_value());
+
+		return _value;
+	}
+
+	constexpr T value() const
+	{
+		if (has_value() == false) [[unlikely]]
+			error().raise();
+
+		return _value;
+	}
+
+	constexpr T value_or(T other) const noexcept
+	{
+		return has_value() ? _value : other;
+	}
+
+	constexpr Errno error() const noexcept
+	{
+		assert(has_value() == false);
+
+		return Errno(static_cast<int> (-_value));
+	}
+};
+
+
+namespace detail {
+
+
+struct AsResult
+{
+	template<std::signed_integral T>
+	Result<T> operator()(T ret) const noexcept
+	{
+		if (ret < 0) [[unlikely]]
+			return Result<T>::failure(Errno::current());
+
+		return Result<T>::success(ret);
+	}
+};
+
+struct AsCodeResult
+{
+	Result<int> operator()(int ret) const noexcept
+	{
+		if (ret != 0) [[unlikely]]
+			return Result<int>::failure(Errno(ret));
+
+		return Result<int>::success(0);
+	}
+};
+
+
+}
+
+
+// Error handler turning the return value of a wrapper following the
+// `-1` and `errno` convention into a `Result`, e.g.
+//
+//   Result<ssize_t> ret = sock.read(buf, len, asresult);
+//
+// Usable with every wrapper taking an `ErrHandler` which passes it `-1`
+// with `errno` set on failure, and with `-fno-exceptions`. It is rejected
+// at compile time by `AddressInfo::resolve()`, whose error codes are not
+// `errno` values.
+//
+inline constexpr detail::AsResult asresult {};
+
+// Same as `asresult` for the wrappers passing an error code instead of
+// setting `errno`, like `Pthread::create()`.
+//
+inline constexpr detail::AsCodeResult ascoderesult {};
+
+
+}
+
+
+#endif
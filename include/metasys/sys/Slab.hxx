@@ -0,0 +1,229 @@
+#ifndef _INCLUDE_METASYS_SYS_SLAB_HXX_
+#define _INCLUDE_METASYS_SYS_SLAB_HXX_
+
+
+#include <sys/mman.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <metasys/sys/MemoryMapping.hxx>
+
+
+namespace metasys {
+
+
+// Fixed capacity allocator of `T` objects referenced by generation tagged
+// handles.
+// A handle packs the index of a slot with the generation of the slot when
+// the object was created. Destroying the object bumps the generation so
+// every handle to it becomes stale, even once the slot is reused, and
+// `get()` then returns `nullptr`.
+// Handles are 64-bit integers meant to be the payload of an
+// `EpollEvent<uint64_t>`: an event for a closed connection can be told
+// apart from an event for a new connection allocated at the same address.
+// The slots live in one anonymous mapping, so only the touched pages use
+// memory and no `malloc()` happens after construction.
+// The slab is not thread-safe.
+//
+template<typename T>
+class Slab
+{
+ public:
+	using Handle = uint64_t;
+
+	// Generation 0 is never live so this handle is always stale.
+	static constexpr Handle INVALID = 0;
+
+
+ private:
+	static constexpr uint32_t NONE = UINT32_MAX;
+
+
+	// A slot is live when its generation is odd.
+	struct Slot
+	{
+		alignas(T) unsigned char  storage[sizeof (T)];
+		uint32_t                  generation;
+		uint32_t                  next;
+	};
+
+
+	MemoryMapping  _mapping;
+	Slot          *_slots;
+	uint32_t       _capacity;
+	uint32_t       _free;
+	uint32_t       _size;
+
+
+	static constexpr Handle _handle(uint32_t index, uint32_t gen) noexcept
+	{
+		return ((static_cast<Handle> (gen) << 32) | index);
+	}
+
+	static constexpr uint32_t _index(Handle handle) noexcept
+	{
+		return static_cast<uint32_t> (handle);
+	}
+
+	static constexpr uint32_t _generation(Handle handle) noexcept
+	{
+		return static_cast<uint32_t> (handle >> 32);
+	}
+
+	T *_object(uint32_t index) noexcept
+	{
+		return std::launder(reinterpret_cast<T *>
+				    (_slots[index].storage));
+	}
+
+	void _destroy(uint32_t index) noexcept
+	{
+		Slot &slot = _slots[index];
+
+		assert((slot.generation & 1) == 1);
+
+		std::destroy_at(_object(index));
+
+		slot.generation += 1;
+		slot.next = _free;
+		_free = index;
+		_size -= 1;
+	}
+
+
+ public:
+	explicit Slab(uint32_t capacity)
+		: _mapping(MemoryMapping::mapinit(capacity * sizeof (Slot),
+						  PROT_READ | PROT_WRITE,
+						  MAP_PRIVATE | MAP_ANONYMOUS))
+		, _slots(static_cast<Slot *> (_mapping.data()))
+		, _capacity(capacity), _free(NONE), _size(0)
+	{
+		uint32_t i;
+
+		assert(capacity > 0);
+		assert(capacity < NONE);
+
+		// Anonymous pages are zeroed: all generations start at 0.
+		for (i = capacity; i > 0; i--) {
+			_slots[i - 1].next = _free;
+			_free = i - 1;
+		}
+	}
+
+	Slab(const Slab &other) = delete;
+
+	~Slab()
+	{
+		uint32_t i;
+
+		if constexpr (std::is_trivially_destructible_v<T> == false) {
+			for (i = 0; (i < _capacity) && (_size > 0); i++)
+				if (_slots[i].generation & 1)
+					_destroy(i);
+		}
+	}
+
+	Slab &operator=(const Slab &other) = delete;
+
+
+	uint32_t capacity() const noexcept
+	{
+		return _capacity;
+	}
+
+	uint32_t size() const noexcept
+	{
+		return _size;
+	}
+
+
+	// Construct a `T` from `args` and return its handle, or `INVALID` if
+	// the slab is full.
+	//
+	template<typename ... Args>
+	Handle create(Args && ... args)
+	{
+		uint32_t index = _free;
+		Slot *slot;
+
+		if (index == NONE) [[unlikely]]
+			return INVALID;
+
+		slot = &_slots[index];
+
+		std::construct_at(reinterpret_cast<T *> (slot->storage),
+				  std::forward<Args>(args) ...);
+
+		_free = slot->next;
+		slot->generation += 1;
+		_size += 1;
+
+		return _handle(index, slot->generation);
+	}
+
+	// Return the object of `handle` or `nullptr` if it has been destroyed
+	// since the handle was created.
+	//
+	T *get(Handle handle) noexcept
+	{
+		uint32_t index = _index(handle);
+
+		// Only live slots have odd generations, which also rejects
+		// `INVALID` on a slot never used yet.
+		if ((_generation(handle) & 1) == 0) [[unlikely]]
+			return nullptr;
+
+		if (index >= _capacity) [[unlikely]]
+			return nullptr;
+
+		if (_slots[index].generation != _generation(handle))
+			return nullptr;
+
+		return _object(index);
+	}
+
+	// Return the handle of a live object of this slab.
+	//
+	Handle handle(const T *object) const noexcept
+	{
+		const Slot *slot = reinterpret_cast<const Slot *> (object);
+		uint32_t index = static_cast<uint32_t> (slot - _slots);
+
+		static_assert (offsetof (Slot, storage) == 0);
+
+		assert(index < _capacity);
+		assert((slot->generation & 1) == 1);
+
+		return _handle(index, slot->generation);
+	}
+
+	// Destroy the object of `handle`. Return `false` if it is stale.
+	//
+	bool destroy(Handle handle) noexcept
+	{
+		if (get(handle) == nullptr)
+			return false;
+
+		_destroy(_index(handle));
+
+		return true;
+	}
+
+	void destroy(T *object) noexcept
+	{
+		_destroy(_index(handle(object)));
+	}
+};
+
+
+}
+
+
+#endif
@@ -43,10 +43,10 @@ class SystemException : public Exception
 		return "generic system metasys exception";
 	}
 
-	[[noreturn]]
+	[[noreturn, gnu::cold]]
 	static void throwErrno();
 
-	[[noreturn]]
+	[[noreturn, gnu::cold]]
 	static void throwErrno(int err);
 };
 
@@ -0,0 +1,165 @@
+#ifndef _INCLUDE_METASYS_SYS_TRACE_HXX_
+#define _INCLUDE_METASYS_SYS_TRACE_HXX_
+
+
+#include <time.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+
+namespace metasys {
+
+
+// System calls instrumented when compiling with `METASYS_TRACE` defined.
+// The whole program, including libmetasys, must be compiled with the same
+// setting.
+//
+enum class TracePoint : unsigned int
+{
+	Read,
+	Write,
+	Pread,
+	Pwrite,
+	Writev,
+	Accept,
+	Connect,
+	EpollWait,
+	COUNT
+};
+
+
+// Statistics of one trace point.
+// Latencies are recorded in a log-linear histogram: values below 16 ns
+// have their own bucket, then every power of two is split in 8 buckets,
+// which bounds the relative error to 12.5%.
+//
+struct TraceStats
+{
+	static constexpr size_t BUCKETS = 16 + 60 * 8;
+
+	uint64_t  calls;
+	uint64_t  errors;
+	uint64_t  nanoseconds;
+	uint64_t  histogram[BUCKETS];
+
+
+	static constexpr size_t bucket(uint64_t ns) noexcept
+	{
+		unsigned int e;
+
+		if (ns < 16)
+			return ns;
+
+		e = 63 - __builtin_clzll(ns);
+
+		return (16 + (e - 4) * 8 + ((ns >> (e - 3)) & 7));
+	}
+
+	// Lowest latency falling in `bucket`.
+	//
+	static constexpr uint64_t lowest(size_t bucket) noexcept
+	{
+		size_t e;
+
+		if (bucket < 16)
+			return bucket;
+
+		e = (bucket - 16) / 8 + 4;
+
+		return ((uint64_t(8) + (bucket - 16) % 8) << (e - 3));
+	}
+
+	// Latency under which `ratio` of the calls completed, rounded down
+	// to the histogram precision.
+	//
+	uint64_t percentile(double ratio) const noexcept;
+};
+
+
+class TraceSnapshot
+{
+	TraceStats  _stats[static_cast<size_t> (TracePoint::COUNT)];
+
+
+ public:
+	constexpr TraceSnapshot() noexcept
+		: _stats{}
+	{
+	}
+
+	const TraceStats &operator[](TracePoint point) const noexcept
+	{
+		return _stats[static_cast<size_t> (point)];
+	}
+
+	TraceStats &operator[](TracePoint point) noexcept
+	{
+		return _stats[static_cast<size_t> (point)];
+	}
+
+	// Name of `point` as it appears in the code, e.g. "epoll_wait".
+	//
+	static const char *name(TracePoint point) noexcept;
+};
+
+
+namespace detail {
+
+
+void tracerecord(TracePoint point, bool error, uint64_t ns) noexcept;
+
+
+}
+
+
+// Sum of the statistics of all the threads, including the exited ones.
+// The counters of running threads are read without stopping them so the
+// snapshot is only consistent per counter.
+//
+TraceSnapshot tracesnapshot();
+
+
+// Call `syscall()` and return its result.
+// With `METASYS_TRACE`, the call is timed and accounted to `Point` in the
+// counters of the calling thread, a negative result being an error, and
+// `errno` is left as `syscall()` set it.
+// Without, this is exactly `syscall()`.
+//
+template<TracePoint Point, typename Syscall>
+[[gnu::always_inline]]
+inline auto traced(Syscall &&syscall)
+	noexcept (noexcept (std::forward<Syscall>(syscall)()))
+{
+#ifdef METASYS_TRACE
+	struct timespec start, end;
+	uint64_t ns;
+	int err;
+
+	::clock_gettime(CLOCK_MONOTONIC, &start);
+
+	auto ret = std::forward<Syscall>(syscall)();
+	err = errno;
+
+	::clock_gettime(CLOCK_MONOTONIC, &end);
+
+	ns = (end.tv_sec - start.tv_sec) * 1000000000ul +
+		end.tv_nsec - start.tv_nsec;
+
+	detail::tracerecord(Point, (ret < 0), ns);
+
+	errno = err;
+
+	return ret;
+#else
+	return std::forward<Syscall>(syscall)();
+#endif
+}
+
+
+}
+
+
+#endif
@@ -0,0 +1,106 @@
+#include <metasys/io/BufferPool.hxx>
+
+#include <sys/mman.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+
+using metasys::BufferPool;
+using metasys::MemoryMapping;
+
+
+static constexpr uint64_t __pack(uint32_t tag, uint32_t index) noexcept
+{
+	return ((static_cast<uint64_t> (tag) << 32) | index);
+}
+
+
+BufferPool::BufferPool(size_t bufsize, uint32_t count)
+	: _mapping(MemoryMapping::mapinit(bufsize * count,
+					  PROT_READ | PROT_WRITE,
+					  MAP_PRIVATE | MAP_ANONYMOUS))
+	, _bufsize(bufsize), _count(count)
+	, _next(std::make_unique<std::atomic<uint32_t>[]>(count))
+	, _head(__pack(0, NONE))
+{
+	uint32_t i;
+
+	assert(bufsize > 0);
+	assert((count > 0) && (count < NONE));
+
+	for (i = count; i > 0; i--)
+		release(_buffer(i - 1));
+}
+
+void *BufferPool::acquire() noexcept
+{
+	uint64_t head = _head.load(std::memory_order_acquire);
+	uint32_t index, next;
+
+	// The tag changes on every update of the head so a concurrent pop
+	// and push of the same buffer makes this CAS fail (ABA).
+	do {
+		index = static_cast<uint32_t> (head);
+
+		if (index == NONE)
+			return nullptr;
+
+		next = _next[index].load(std::memory_order_relaxed);
+	} while (_head.compare_exchange_weak
+		 (head, __pack((head >> 32) + 1, next),
+		  std::memory_order_acquire, std::memory_order_acquire)
+		 == false);
+
+	return _buffer(index);
+}
+
+void BufferPool::release(void *buf) noexcept
+{
+	uint32_t index = _index(buf);
+	uint64_t head = _head.load(std::memory_order_relaxed);
+
+	do {
+		_next[index].store(static_cast<uint32_t> (head),
+				   std::memory_order_relaxed);
+	} while (_head.compare_exchange_weak
+		 (head, __pack((head >> 32) + 1, index),
+		  std::memory_order_release, std::memory_order_relaxed)
+		 == false);
+}
+
+
+BufferPool::Cache::Cache(BufferPool &pool, size_t capacity)
+	: _pool(pool), _capacity(capacity)
+{
+	assert(capacity >= 2);
+
+	_free.reserve(capacity);
+}
+
+BufferPool::Cache::~Cache()
+{
+	for (void *buf : _free)
+		_pool.release(buf);
+}
+
+void BufferPool::Cache::refill() noexcept
+{
+	void *buf;
+
+	while (_free.size() < (_capacity / 2)) {
+		if ((buf = _pool.acquire()) == nullptr)
+			break;
+		_free.push_back(buf);
+	}
+}
+
+void BufferPool::Cache::spill() noexcept
+{
+	while (_free.size() > (_capacity / 2)) {
+		_pool.release(_free.back());
+		_free.pop_back();
+	}
+}
@@ -0,0 +1,154 @@
+#include <metasys/io/DelimiterScanner.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#  include <immintrin.h>
+#endif
+
+#include <metasys/sys/CpuFeatures.hxx>
+
+
+using metasys::DelimiterScanner;
+using metasys::detail::CpuFeatures;
+using metasys::detail::cpufeatures;
+
+
+static size_t __find_scalar(const uint64_t *bitmap, const uint8_t *buf,
+			    size_t len) noexcept
+{
+	size_t i;
+	uint8_t c;
+
+	for (i = 0; i < len; i++) {
+		c = buf[i];
+		if ((bitmap[c >> 6] >> (c & 63)) & 1)
+			break;
+	}
+
+	return i;
+}
+
+
+#if defined(__x86_64__)
+
+static size_t __find_sse2(const uint64_t *bitmap, const uint8_t *bytes,
+			  size_t count, const uint8_t *buf, size_t len)
+	noexcept
+{
+	__m128i delims[DelimiterScanner::SIMD_MAX];
+	__m128i chunk, hits;
+	size_t i, j;
+	int mask;
+
+	for (j = 0; j < count; j++)
+		delims[j] = _mm_set1_epi8(static_cast<char> (bytes[j]));
+
+	for (i = 0; (i + 16) <= len; i += 16) {
+		chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>
+					(buf + i));
+		hits = _mm_cmpeq_epi8(chunk, delims[0]);
+
+		for (j = 1; j < count; j++)
+			hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk,
+								 delims[j]));
+
+		if ((mask = _mm_movemask_epi8(hits)) != 0)
+			return (i + __builtin_ctz(mask));
+	}
+
+	return (i + __find_scalar(bitmap, buf + i, len - i));
+}
+
+[[gnu::target("avx2")]]
+static size_t __find_avx2(const uint64_t *bitmap, const uint8_t *bytes,
+			  size_t count, const uint8_t *buf, size_t len)
+	noexcept
+{
+	__m256i delims[DelimiterScanner::SIMD_MAX];
+	__m256i chunk, hits;
+	size_t i, j;
+	uint32_t mask;
+
+	for (j = 0; j < count; j++)
+		delims[j] = _mm256_set1_epi8(static_cast<char> (bytes[j]));
+
+	for (i = 0; (i + 32) <= len; i += 32) {
+		chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>
+					   (buf + i));
+		hits = _mm256_cmpeq_epi8(chunk, delims[0]);
+
+		for (j = 1; j < count; j++)
+			hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8
+					       (chunk, delims[j]));
+
+		mask = static_cast<uint32_t> (_mm256_movemask_epi8(hits));
+
+		if (mask != 0)
+			return (i + __builtin_ctz(mask));
+	}
+
+	return (i + __find_sse2(bitmap, bytes, count, buf + i, len - i));
+}
+
+static DelimiterScanner::Isa __detect_isa() noexcept
+{
+	const CpuFeatures cpu = cpufeatures();
+
+	if (cpu.avx2)
+		return DelimiterScanner::Isa::Avx2;
+
+	return DelimiterScanner::Isa::Sse2;
+}
+
+#else
+
+static DelimiterScanner::Isa __detect_isa() noexcept
+{
+	return DelimiterScanner::Isa::Scalar;
+}
+
+#endif
+
+
+static const DelimiterScanner::Isa __isa = __detect_isa();
+
+
+DelimiterScanner::Isa DelimiterScanner::isa() noexcept
+{
+	return __isa;
+}
+
+size_t DelimiterScanner::find(const void *buf, size_t len) const noexcept
+{
+	return find(buf, len, __isa);
+}
+
+size_t DelimiterScanner::find(const void *buf, size_t len, Isa isa) const
+	noexcept
+{
+	const uint8_t *ptr = static_cast<const uint8_t *> (buf);
+	const void *found;
+
+	if ((_count == 1) && (isa != Isa::Scalar)) {
+		if ((found = std::memchr(ptr, _bytes[0], len)) == nullptr)
+			return len;
+		return (static_cast<const uint8_t *> (found) - ptr);
+	}
+
+	if (_count > SIMD_MAX)
+		isa = Isa::Scalar;
+
+	switch (isa) {
+#if defined(__x86_64__)
+	case Isa::Avx2:
+		return __find_avx2(_bitmap, _bytes, _count, ptr, len);
+	case Isa::Sse2:
+		return __find_sse2(_bitmap, _bytes, _count, ptr, len);
+#endif
+	default:
+		return __find_scalar(_bitmap, ptr, len);
+	}
+}
@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdlib>
 
 #include <metasys/net/ResolveException.hxx>
 #include <metasys/sys/SystemException.hxx>
@@ -177,5 +178,7 @@ void AddressInfo::resolvethrow(int ret)
 		throw ResolveException<EAI_SERVICE>();
 	case EAI_SYSTEM:
 		SystemException::throwErrno();
+	default:
+		::abort();
 	}
 }
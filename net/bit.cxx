@@ -0,0 +1,165 @@
+#include <metasys/net/bit.hxx>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__x86_64__)
+#  include <immintrin.h>
+#endif
+
+#include <metasys/sys/CpuFeatures.hxx>
+
+
+using metasys::BswapIsa;
+using metasys::detail::CpuFeatures;
+using metasys::detail::cpufeatures;
+
+
+template<typename T>
+static void __bswap_scalar(const T *src, T *dest, size_t len) noexcept
+{
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		dest[i] = metasys::bswap(src[i]);
+}
+
+
+#if defined(__x86_64__)
+
+// Shuffle control reversing the bytes of each `T` in a 16 bytes lane.
+//
+template<typename T>
+static constexpr char __shuffle(int i) noexcept
+{
+	return static_cast<char> ((i / sizeof (T)) * sizeof (T) +
+				  (sizeof (T) - 1 - (i % sizeof (T))));
+}
+
+template<typename T>
+[[gnu::target("ssse3")]]
+static void __bswap_ssse3(const T *src, T *dest, size_t len) noexcept
+{
+	constexpr size_t step = 16 / sizeof (T);
+	const __m128i mask = _mm_setr_epi8
+		(__shuffle<T>(0), __shuffle<T>(1), __shuffle<T>(2),
+		 __shuffle<T>(3), __shuffle<T>(4), __shuffle<T>(5),
+		 __shuffle<T>(6), __shuffle<T>(7), __shuffle<T>(8),
+		 __shuffle<T>(9), __shuffle<T>(10), __shuffle<T>(11),
+		 __shuffle<T>(12), __shuffle<T>(13), __shuffle<T>(14),
+		 __shuffle<T>(15));
+	__m128i chunk;
+	size_t i;
+
+	for (i = 0; (i + step) <= len; i += step) {
+		chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>
+					(src + i));
+		chunk = _mm_shuffle_epi8(chunk, mask);
+		_mm_storeu_si128(reinterpret_cast<__m128i *> (dest + i), chunk);
+	}
+
+	__bswap_scalar(src + i, dest + i, len - i);
+}
+
+template<typename T>
+[[gnu::target("avx2")]]
+static void __bswap_avx2(const T *src, T *dest, size_t len) noexcept
+{
+	constexpr size_t step = 32 / sizeof (T);
+	const __m256i mask = _mm256_setr_epi8
+		(__shuffle<T>(0), __shuffle<T>(1), __shuffle<T>(2),
+		 __shuffle<T>(3), __shuffle<T>(4), __shuffle<T>(5),
+		 __shuffle<T>(6), __shuffle<T>(7), __shuffle<T>(8),
+		 __shuffle<T>(9), __shuffle<T>(10), __shuffle<T>(11),
+		 __shuffle<T>(12), __shuffle<T>(13), __shuffle<T>(14),
+		 __shuffle<T>(15), __shuffle<T>(0), __shuffle<T>(1),
+		 __shuffle<T>(2), __shuffle<T>(3), __shuffle<T>(4),
+		 __shuffle<T>(5), __shuffle<T>(6), __shuffle<T>(7),
+		 __shuffle<T>(8), __shuffle<T>(9), __shuffle<T>(10),
+		 __shuffle<T>(11), __shuffle<T>(12), __shuffle<T>(13),
+		 __shuffle<T>(14), __shuffle<T>(15));
+	__m256i chunk;
+	size_t i;
+
+	for (i = 0; (i + step) <= len; i += step) {
+		chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>
+					   (src + i));
+		chunk = _mm256_shuffle_epi8(chunk, mask);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *> (dest + i),
+				    chunk);
+	}
+
+	__bswap_ssse3(src + i, dest + i, len - i);
+}
+
+static BswapIsa __detect_isa() noexcept
+{
+	const CpuFeatures cpu = cpufeatures();
+
+	if (cpu.avx2)
+		return BswapIsa::Avx2;
+	if (cpu.ssse3)
+		return BswapIsa::Ssse3;
+
+	return BswapIsa::Scalar;
+}
+
+#else
+
+static BswapIsa __detect_isa() noexcept
+{
+	return BswapIsa::Scalar;
+}
+
+#endif
+
+
+static const BswapIsa __isa = __detect_isa();
+
+
+template<typename T>
+static void __bswap(std::span<const T> src, std::span<T> dest, BswapIsa isa)
+	noexcept
+{
+	assert(dest.size() >= src.size());
+
+	switch (isa) {
+#if defined(__x86_64__)
+	case BswapIsa::Avx2:
+		__bswap_avx2(src.data(), dest.data(), src.size());
+		break;
+	case BswapIsa::Ssse3:
+		__bswap_ssse3(src.data(), dest.data(), src.size());
+		break;
+#endif
+	default:
+		__bswap_scalar(src.data(), dest.data(), src.size());
+		break;
+	}
+}
+
+
+BswapIsa metasys::bswapisa() noexcept
+{
+	return __isa;
+}
+
+void metasys::bswap(std::span<const uint16_t> src, std::span<uint16_t> dest,
+		    BswapIsa isa) noexcept
+{
+	__bswap(src, dest, isa);
+}
+
+void metasys::bswap(std::span<const uint32_t> src, std::span<uint32_t> dest,
+		    BswapIsa isa) noexcept
+{
+	__bswap(src, dest, isa);
+}
+
+void metasys::bswap(std::span<const uint64_t> src, std::span<uint64_t> dest,
+		    BswapIsa isa) noexcept
+{
+	__bswap(src, dest, isa);
+}
@@ -0,0 +1,175 @@
+#include <metasys/sched/PthreadRegistry.hxx>
+
+#include <pthread.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include <metasys/sched/PthreadMutex.hxx>
+
+
+using metasys::PthreadMutex;
+using metasys::PthreadRegistry;
+using metasys::PthreadSample;
+
+
+// Registry entry of one thread, living in its thread local storage so it
+// unlinks itself when the thread exits.
+//
+struct PthreadEntry
+{
+	PthreadSample  sample;
+	clockid_t      clock;
+	bool           listed;
+	PthreadEntry  *prev;
+	PthreadEntry  *next;
+
+	~PthreadEntry();
+
+	void link() noexcept;
+	void unlink() noexcept;
+};
+
+
+static PthreadMutex   __lock;
+static PthreadEntry  *__threads = nullptr;
+static size_t         __count = 0;
+
+static thread_local PthreadEntry __self;
+
+
+PthreadEntry::~PthreadEntry()
+{
+	if (listed) {
+		__lock.lock();
+		unlink();
+		__lock.unlock();
+	}
+}
+
+void PthreadEntry::link() noexcept
+{
+	prev = nullptr;
+	next = __threads;
+	if (next != nullptr)
+		next->prev = this;
+	__threads = this;
+	__count += 1;
+	listed = true;
+}
+
+void PthreadEntry::unlink() noexcept
+{
+	if (prev != nullptr)
+		prev->next = next;
+	else
+		__threads = next;
+	if (next != nullptr)
+		next->prev = prev;
+	__count -= 1;
+	listed = false;
+}
+
+
+void PthreadRegistry::enlist(const char *name) noexcept
+{
+	PthreadEntry &self = __self;
+	char buf[sizeof (self.sample.name)];
+	int ret [[maybe_unused]];
+
+	if (name != nullptr) {
+		std::strncpy(buf, name, sizeof (buf) - 1);
+		buf[sizeof (buf) - 1] = '\0';
+		::pthread_setname_np(::pthread_self(), buf);
+	} else {
+		if (::pthread_getname_np(::pthread_self(), buf, sizeof (buf))
+		    != 0)
+			buf[0] = '\0';
+	}
+
+	__lock.lock();
+
+	std::memcpy(self.sample.name, buf, sizeof (buf));
+
+	if (self.listed == false) {
+		self.sample.thread = ::pthread_self();
+		self.sample.tid = ::gettid();
+
+		ret = ::pthread_getcpuclockid(self.sample.thread,
+					      &self.clock);
+		assert(ret == 0);
+
+		self.link();
+	}
+
+	__lock.unlock();
+}
+
+void PthreadRegistry::delist() noexcept
+{
+	PthreadEntry &self = __self;
+
+	__lock.lock();
+
+	if (self.listed)
+		self.unlink();
+
+	__lock.unlock();
+}
+
+bool PthreadRegistry::listed() noexcept
+{
+	return __self.listed;
+}
+
+
+size_t PthreadRegistry::snapshot(std::span<PthreadSample> dest) noexcept
+{
+	const PthreadEntry *cur;
+	struct timespec ts;
+	size_t i = 0, ret;
+
+	__lock.lock();
+
+	for (cur = __threads; cur != nullptr; cur = cur->next) {
+		if (i == dest.size())
+			break;
+
+		dest[i] = cur->sample;
+
+		if (::clock_gettime(cur->clock, &ts) == 0)
+			dest[i].cputime = ts.tv_sec * 1000000000ul
+				+ ts.tv_nsec;
+		else
+			dest[i].cputime = 0;
+
+		i += 1;
+	}
+
+	ret = __count;
+
+	__lock.unlock();
+
+	return ret;
+}
+
+std::vector<PthreadSample> PthreadRegistry::snapshot()
+{
+	std::vector<PthreadSample> ret(8);
+	size_t n;
+
+	// Retry only if threads were enlisted between the calls.
+	while ((n = snapshot(ret)) > ret.size())
+		ret.resize(n);
+
+	ret.resize(n);
+
+	return ret;
+}
@@ -0,0 +1,48 @@
+#include <metasys/sched/Rseq.hxx>
+
+#include <sys/rseq.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+#if defined(__x86_64__)
+
+// Area registered by threads glibc did not register, which happens when
+// glibc is told not to with the `glibc.pthread.rseq` tunable.
+// The kernel stops using it when the thread exits, before its thread local
+// storage is released.
+//
+static thread_local struct rseq __area = {
+	.cpu_id_start = 0,
+	.cpu_id = static_cast<uint32_t> (RSEQ_CPU_ID_UNINITIALIZED),
+	.rseq_cs = 0,
+	.flags = 0
+};
+
+static thread_local int __registered = 0;
+
+
+struct rseq *metasys::detail::rseqarea() noexcept
+{
+	if (__registered == 0) [[unlikely]] {
+		if (::syscall(SYS_rseq, &__area, sizeof (__area), 0, RSEQ_SIG)
+		    == 0)
+			__registered = 1;
+		else
+			__registered = -1;
+	}
+
+	if (__registered < 0)
+		return nullptr;
+
+	return &__area;
+}
+
+#else
+
+struct rseq *metasys::detail::rseqarea() noexcept
+{
+	return nullptr;
+}
+
+#endif
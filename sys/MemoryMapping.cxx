@@ -0,0 +1,39 @@
+#include <metasys/sys/MemoryMapping.hxx>
+
+#include <cstddef>
+
+
+using metasys::MemoryMapping;
+
+
+MemoryMapping::MemoryMapping(MemoryMapping &&other) noexcept
+	: _addr(other._addr), _len(other._len)
+{
+	other._addr = nullptr;
+	other._len = 0;
+}
+
+MemoryMapping &MemoryMapping::operator=(MemoryMapping &&other) noexcept
+{
+	if (valid()) {
+		if (other._addr != _addr) [[likely]]
+			unmap();
+	}
+
+	_addr = other._addr;
+	_len = other._len;
+	other._addr = nullptr;
+	other._len = 0;
+
+	return *this;
+}
+
+void *MemoryMapping::reset(void *addr, size_t len) noexcept
+{
+	void *tmp = _addr;
+
+	_addr = addr;
+	_len = len;
+
+	return tmp;
+}
@@ -45,14 +45,24 @@ void SystemException::throwErrno(int err)
 		throw ErrnoException<EADDRNOTAVAIL>();
 	case EAGAIN:
 		throw ErrnoException<EAGAIN>();
+	case EBUSY:
+		throw ErrnoException<EBUSY>();
+	case ECONNABORTED:
+		throw ErrnoException<ECONNABORTED>();
 	case ECONNREFUSED:
 		throw ErrnoException<ECONNREFUSED>();
+	case ECONNRESET:
+		throw ErrnoException<ECONNRESET>();
 	case EDESTADDRREQ:
 		throw ErrnoException<EDESTADDRREQ>();
 	case EDQUOT:
 		throw ErrnoException<EDQUOT>();
+	case EEXIST:
+		throw ErrnoException<EEXIST>();
 	case EFBIG:
 		throw ErrnoException<EFBIG>();
+	case EHOSTUNREACH:
+		throw ErrnoException<EHOSTUNREACH>();
 	case EINPROGRESS:
 		throw ErrnoException<EINPROGRESS>();
 	case EINTR:
@@ -61,34 +71,56 @@ void SystemException::throwErrno(int err)
 		throw ErrnoException<EINVAL>();
 	case EIO:
 		throw ErrnoException<EIO>();
+	case EISDIR:
+		throw ErrnoException<EISDIR>();
 	case ELOOP:
 		throw ErrnoException<ELOOP>();
 	case EMFILE:
 		throw ErrnoException<EMFILE>();
+	case EMSGSIZE:
+		throw ErrnoException<EMSGSIZE>();
+	case ENAMETOOLONG:
+		throw ErrnoException<ENAMETOOLONG>();
+	case ENETUNREACH:
+		throw ErrnoException<ENETUNREACH>();
 	case ENFILE:
 		throw ErrnoException<ENFILE>();
 	case ENOBUFS:
 		throw ErrnoException<ENOBUFS>();
+	case ENODEV:
+		throw ErrnoException<ENODEV>();
 	case ENOENT:
 		throw ErrnoException<ENOENT>();
 	case ENOMEM:
 		throw ErrnoException<ENOMEM>();
 	case ENOSPC:
 		throw ErrnoException<ENOSPC>();
+	case ENOTCONN:
+		throw ErrnoException<ENOTCONN>();
 	case ENOTDIR:
 		throw ErrnoException<ENOTDIR>();
+	case ENXIO:
+		throw ErrnoException<ENXIO>();
+	case EOPNOTSUPP:
+		throw ErrnoException<EOPNOTSUPP>();
 	case EOVERFLOW:
 		throw ErrnoException<EOVERFLOW>();
 	case EPERM:
 		throw ErrnoException<EPERM>();
 	case EPIPE:
 		throw ErrnoException<EPIPE>();
+	case EPROTO:
+		throw ErrnoException<EPROTO>();
+	case ERANGE:
+		throw ErrnoException<ERANGE>();
 	case EROFS:
 		throw ErrnoException<EROFS>();
 	case ESRCH:
 		throw ErrnoException<ESRCH>();
 	case ETIMEDOUT:
 		throw ErrnoException<ETIMEDOUT>();
+	case ETXTBSY:
+		throw ErrnoException<ETXTBSY>();
 	default:
 		::abort();
 	}
@@ -0,0 +1,172 @@
+#include <metasys/sys/Trace.hxx>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <metasys/sched/PthreadMutex.hxx>
+
+
+using metasys::PthreadMutex;
+using metasys::TracePoint;
+using metasys::TraceSnapshot;
+using metasys::TraceStats;
+
+
+static constexpr size_t __npoints = static_cast<size_t> (TracePoint::COUNT);
+
+
+// Counters of one thread.
+// Only the owner thread writes them, so updates are plain load and store
+// and other threads can read them at any time for a snapshot.
+//
+struct TraceCounters
+{
+	struct Point
+	{
+		std::atomic<uint64_t>  calls;
+		std::atomic<uint64_t>  errors;
+		std::atomic<uint64_t>  nanoseconds;
+		std::atomic<uint64_t>  histogram[TraceStats::BUCKETS];
+	};
+
+	Point           points[__npoints];
+	TraceCounters  *prev;
+	TraceCounters  *next;
+
+	TraceCounters() noexcept;
+	~TraceCounters();
+
+	void addto(TraceSnapshot *dest) const noexcept;
+};
+
+
+static PthreadMutex    __lock;
+static TraceCounters  *__threads = nullptr;
+static TraceSnapshot   __exited;
+
+
+static inline void __incr(std::atomic<uint64_t> &counter, uint64_t n)
+	noexcept
+{
+	counter.store(counter.load(std::memory_order_relaxed) + n,
+		      std::memory_order_relaxed);
+}
+
+
+TraceCounters::TraceCounters() noexcept
+	: points{}, prev(nullptr)
+{
+	__lock.lock();
+
+	next = __threads;
+	if (next != nullptr)
+		next->prev = this;
+	__threads = this;
+
+	__lock.unlock();
+}
+
+TraceCounters::~TraceCounters()
+{
+	__lock.lock();
+
+	addto(&__exited);
+
+	if (prev != nullptr)
+		prev->next = next;
+	else
+		__threads = next;
+	if (next != nullptr)
+		next->prev = prev;
+
+	__lock.unlock();
+}
+
+void TraceCounters::addto(TraceSnapshot *dest) const noexcept
+{
+	size_t p, b;
+
+	for (p = 0; p < __npoints; p++) {
+		const Point &src = points[p];
+		TraceStats &stats = (*dest)[static_cast<TracePoint> (p)];
+
+		stats.calls += src.calls.load(std::memory_order_relaxed);
+		stats.errors += src.errors.load(std::memory_order_relaxed);
+		stats.nanoseconds +=
+			src.nanoseconds.load(std::memory_order_relaxed);
+
+		for (b = 0; b < TraceStats::BUCKETS; b++)
+			stats.histogram[b] +=
+				src.histogram[b].load(std::memory_order_relaxed);
+	}
+}
+
+
+void metasys::detail::tracerecord(TracePoint point, bool error, uint64_t ns)
+	noexcept
+{
+	static thread_local TraceCounters counters;
+	TraceCounters::Point &dest = counters.points[static_cast<size_t>
+						     (point)];
+
+	__incr(dest.calls, 1);
+	__incr(dest.nanoseconds, ns);
+	__incr(dest.histogram[TraceStats::bucket(ns)], 1);
+
+	if (error)
+		__incr(dest.errors, 1);
+}
+
+TraceSnapshot metasys::tracesnapshot()
+{
+	TraceSnapshot ret;
+	const TraceCounters *cur;
+
+	__lock.lock();
+
+	ret = __exited;
+
+	for (cur = __threads; cur != nullptr; cur = cur->next)
+		cur->addto(&ret);
+
+	__lock.unlock();
+
+	return ret;
+}
+
+
+uint64_t TraceStats::percentile(double ratio) const noexcept
+{
+	uint64_t target, seen = 0;
+	size_t b;
+
+	if (calls == 0)
+		return 0;
+
+	target = static_cast<uint64_t> (ratio * calls);
+
+	for (b = 0; b < BUCKETS; b++) {
+		seen += histogram[b];
+		if (seen > target)
+			return lowest(b);
+	}
+
+	return lowest(BUCKETS - 1);
+}
+
+
+const char *TraceSnapshot::name(TracePoint point) noexcept
+{
+	switch (point) {
+	case TracePoint::Read:       return "read";
+	case TracePoint::Write:      return "write";
+	case TracePoint::Pread:      return "pread";
+	case TracePoint::Pwrite:     return "pwrite";
+	case TracePoint::Writev:     return "writev";
+	case TracePoint::Accept:     return "accept";
+	case TracePoint::Connect:    return "connect";
+	case TracePoint::EpollWait:  return "epoll_wait";
+	default:                     return "unknown";
+	}
+}
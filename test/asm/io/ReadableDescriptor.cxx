@@ -0,0 +1,70 @@
+#include <metasys/io/ReadableDescriptor.hxx>
+
+#include <unistd.h>
+
+#include <cerrno>
+
+#include <asmcmp.hxx>
+
+#include <metasys/sys/SystemException.hxx>
+
+
+using metasys::ReadableDescriptor;
+using metasys::SystemException;
+
+
+[[noreturn, gnu::cold, gnu::noinline]]
+static void __fail()
+{
+	SystemException::throwErrno();
+}
+
+
+Model(ReadLoopUnsafe)
+{
+	char buf[64];
+
+	while (::read(STDIN_FILENO, buf, sizeof (buf)) > 0)
+		asm volatile ("nop");
+}
+Test(ReadLoopUnsafe)
+{
+	ReadableDescriptor fd = ReadableDescriptor(STDIN_FILENO);
+	char buf[64];
+
+	while (fd.read(buf, sizeof (buf), [](ssize_t r) { return r; }) > 0)
+		asm volatile ("nop");
+}
+
+
+// The error path of the throwing variant must be moved out of the loop
+// like a call to a cold function, leaving the same hot blocks as above.
+//
+Model(ReadLoopSafe)
+{
+	char buf[64];
+	ssize_t ret;
+
+	while (true) {
+		ret = ::read(STDIN_FILENO, buf, sizeof (buf));
+
+		if (ret < 0) [[unlikely]] {
+			if ((errno == EAGAIN) || (errno == EINTR))
+				continue;
+			__fail();
+		}
+
+		if (ret == 0)
+			break;
+
+		asm volatile ("nop");
+	}
+}
+Test(ReadLoopSafe)
+{
+	ReadableDescriptor fd = ReadableDescriptor(STDIN_FILENO);
+	char buf[64];
+
+	while (fd.read(buf, sizeof (buf)) > 0)
+		asm volatile ("nop");
+}
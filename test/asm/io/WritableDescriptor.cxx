@@ -0,0 +1,56 @@
+#include <metasys/io/WritableDescriptor.hxx>
+
+#include <unistd.h>
+
+#include <cerrno>
+
+#include <asmcmp.hxx>
+
+#include <metasys/sys/SystemException.hxx>
+
+
+using metasys::SystemException;
+using metasys::WritableDescriptor;
+
+
+[[noreturn, gnu::cold, gnu::noinline]]
+static void __fail()
+{
+	SystemException::throwErrno();
+}
+
+
+// The error path of the throwing variant must be moved out of the loop
+// like a call to a cold function.
+//
+Model(WriteLoopSafe)
+{
+	char buf[64] = {};
+	ssize_t ret;
+	int i;
+
+	for (i = 0; i < 16; i++) {
+	retry:
+		ret = ::write(STDOUT_FILENO, buf, sizeof (buf));
+
+		if (ret <= 0) [[unlikely]] {
+			if ((errno == EAGAIN) || (errno == EINTR))
+				goto retry;
+			__fail();
+		}
+
+		asm volatile ("nop");
+	}
+}
+Test(WriteLoopSafe)
+{
+	WritableDescriptor fd = WritableDescriptor(STDOUT_FILENO);
+	char buf[64] = {};
+	int i;
+
+	for (i = 0; i < 16; i++) {
+		fd.write(buf, sizeof (buf));
+
+		asm volatile ("nop");
+	}
+}
@@ -20,7 +20,7 @@ Model(ConnectBindListenUnsafe)
 
 	fd = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
 
-	Overhead(struct sockaddr_in sin, struct sockaddr_in sin = {});
+	struct sockaddr_in sin;
 	sin.sin_family = AF_INET;
 	sin.sin_port = htons(9000);
 	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
@@ -43,7 +43,7 @@ Test(ConnectBindListenUnsafe)
 
 Model(ListenInitSafe)
 {
-	Overhead(struct sockaddr_in sin, struct sockaddr_in sin = {});
+	struct sockaddr_in sin;
 	int fd;
 
 	sin.sin_family = AF_INET;
@@ -76,9 +76,10 @@ Test(ListenInitSafe)
 	asm volatile ("nop");
 }
 
+Environment(ListenInitAcceptSafe, LoopbackClient);
 Model(ListenInitAcceptSafe)
 {
-	Overhead(struct sockaddr_in sin, struct sockaddr_in sin = {});
+	struct sockaddr_in sin;
 	socklen_t slen;
 	int fd, conn;
 
@@ -12,16 +12,10 @@ using metasys::InetAddress;
 using metasys::TcpSocket;
 
 
+Environment(ConnectInitUnsafe, LoopbackServer);
 Model(ConnectInitUnsafe)
 {
-	// TODO: change `InetAddress` so it does not do the `sin = {}`.
-	//
-	// The `struct sockaddr_in` contains a field `sin_zero` to pad it at
-	// the size of `struct sockaddr`.
-	// Because `InetAddress` constructors are `constexpr`, g++ needs to
-	// initialize even this `sin_zero` field whereas nobody needs it.
-	//
-	Overhead(struct sockaddr_in sin, struct sockaddr_in sin = {});
+	struct sockaddr_in sin;
 	int fd;
 
 	sin.sin_family = AF_INET;
@@ -44,9 +38,10 @@ Test(ConnectInitUnsafe)
 	sock.close([](auto){});
 }
 
+Environment(ConnectInitSafe, LoopbackServer);
 Model(ConnectInitSafe)
 {
-	Overhead(struct sockaddr_in sin, struct sockaddr_in sin = {});
+	struct sockaddr_in sin;
 	int fd;
 
 	sin.sin_family = AF_INET;
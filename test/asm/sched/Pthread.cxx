@@ -14,6 +14,7 @@ static void *__routine_CreateNopFuncSafe(void *)
 	return NULL;
 }
 
+Environment(CreateNopFuncSafe, LeaksResources);
 Model(CreateNopFuncSafe)
 {
 	Overhead(pthread_t tid, pthread_t tid = {});
@@ -36,6 +37,7 @@ Test(CreateNopFuncSafe)
 }
 
 
+Environment(CreateinitNopFuncSafe, LeaksResources);
 Model(CreateinitNopFuncSafe)
 {
 	pthread_t tid;
@@ -58,6 +60,7 @@ Test(CreateinitNopFuncSafe)
 }
 
 
+Environment(CreateNopFuncUnsafe, LeaksResources);
 Model(CreateNopFuncUnsafe)
 {
 	Overhead(pthread_t tid, pthread_t tid = {});
@@ -72,6 +75,7 @@ Test(CreateNopFuncUnsafe)
 }
 
 
+Environment(JoinVoidPtr, NotRunnable);
 Model(JoinVoidPtr)
 {
 	pthread_t tid = 0;
@@ -92,6 +96,7 @@ Test(JoinVoidPtr)
 }
 
 
+Environment(JoinIgnoreVoidPtr, NotRunnable);
 Model(JoinIgnoreVoidPtr)
 {
 	pthread_t tid = 0;
@@ -106,6 +111,7 @@ Test(JoinIgnoreVoidPtr)
 }
 
 
+Environment(Detach, NotRunnable);
 Model(Detach)
 {
 	pthread_t tid = 0;
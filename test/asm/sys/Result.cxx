@@ -0,0 +1,40 @@
+#include <metasys/sys/Result.hxx>
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+
+#include <asmcmp.hxx>
+
+#include <metasys/io/ReadableDescriptor.hxx>
+
+
+using metasys::asresult;
+using metasys::ReadableDescriptor;
+using metasys::Result;
+
+
+Model(ReadResult)
+{
+	char buf[64];
+	ssize_t ret;
+
+	ret = ::read(STDIN_FILENO, buf, sizeof (buf));
+
+	if (ret >= 0) [[likely]]
+		printf("read %ld\n", ret);
+	else
+		printf("error %d\n", errno);
+}
+Test(ReadResult)
+{
+	ReadableDescriptor fd = ReadableDescriptor(STDIN_FILENO);
+	char buf[64];
+	Result<ssize_t> ret = fd.read(buf, sizeof (buf), asresult);
+
+	if (ret) [[likely]]
+		printf("read %ld\n", *ret);
+	else
+		printf("error %d\n", ret.error().value());
+}
@@ -0,0 +1,27 @@
+#include <metasys/sys/Trace.hxx>
+
+#include <unistd.h>
+
+#include <asmcmp.hxx>
+
+
+using metasys::TracePoint;
+using metasys::traced;
+
+
+Model(TracedRead)
+{
+	char c;
+
+	if (::read(STDIN_FILENO, &c, 1) < 0)
+		throw 0;
+}
+Test(TracedRead)
+{
+	char c;
+
+	if (traced<TracePoint::Read>([&]() {
+		return ::read(STDIN_FILENO, &c, 1);
+	}) < 0)
+		throw 0;
+}
@@ -0,0 +1,182 @@
+#include <metasys/fs/Directory.hxx>
+#include <metasys/fs/DirectoryDescriptor.hxx>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <bench.hxx>
+
+
+using metasys::Directory;
+using metasys::DirectoryBatch;
+using metasys::DirectoryDescriptor;
+
+
+static constexpr size_t __BATCH = 65536;
+
+
+// Directory populated on first use with `$BENCH_DIRSIZE` empty files
+// (1000000 by default), on tmpfs when `/dev/shm` exists, and removed at
+// exit.
+// The reported time is the time to scan the whole directory.
+//
+static std::string   __path;
+static size_t        __size;
+
+static void __cleanup()
+{
+	std::string name;
+	size_t i;
+
+	for (i = 0; i < __size; i++) {
+		name = __path + "/" + std::to_string(i);
+		::unlink(name.c_str());
+	}
+
+	::rmdir(__path.c_str());
+}
+
+static const char *__directory()
+{
+	const char *env;
+	std::string name;
+	char tmpl[64];
+	size_t i;
+	int fd;
+
+	if (__path.empty() == false)
+		return __path.c_str();
+
+	if (::access("/dev/shm", W_OK) == 0)
+		strcpy(tmpl, "/dev/shm/metasys-bench.XXXXXX");
+	else
+		strcpy(tmpl, "/tmp/metasys-bench.XXXXXX");
+
+	if (::mkdtemp(tmpl) == nullptr) {
+		perror("mkdtemp");
+		exit(1);
+	}
+
+	__path = tmpl;
+
+	if ((env = ::getenv("BENCH_DIRSIZE")) != nullptr)
+		__size = strtoul(env, nullptr, 10);
+	else
+		__size = 1000000;
+
+	::atexit(__cleanup);
+
+	for (i = 0; i < __size; i++) {
+		name = __path + "/" + std::to_string(i);
+		fd = ::open(name.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0600);
+		if (fd < 0) {
+			perror("open");
+			exit(1);
+		}
+		::close(fd);
+	}
+
+	return __path.c_str();
+}
+
+
+Libc(DirectoryScan)
+{
+	const char *path = __directory();
+	struct dirent *entry;
+	uint64_t i, sum = 0;
+	DIR *dh;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		if ((dh = ::opendir(path)) == nullptr)
+			break;
+		while ((entry = ::readdir(dh)) != nullptr)
+			sum += entry->d_type;
+		::closedir(dh);
+	}
+
+	bench.stop();
+
+	__bench_keep(sum);
+}
+Metasys(DirectoryScan)
+{
+	const char *path = __directory();
+	uint64_t i, sum = 0;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		Directory dir = Directory(path);
+
+		for (const Directory::Entry &entry : dir)
+			sum += entry.d_type;
+	}
+
+	bench.stop();
+
+	__bench_keep(sum);
+}
+
+
+Libc(DirectoryScanBatch)
+{
+	static uint8_t buf[__BATCH];
+	const char *path = __directory();
+	uint64_t i, sum = 0;
+	ssize_t len, off;
+	int fd;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		fd = ::open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fd < 0)
+			break;
+		while ((len = ::getdents64(fd, buf, sizeof (buf))) > 0) {
+			for (off = 0; off < len; ) {
+				struct dirent64 *entry =
+					reinterpret_cast<struct dirent64 *>
+					(buf + off);
+
+				sum += entry->d_type;
+				off += entry->d_reclen;
+			}
+		}
+		::close(fd);
+	}
+
+	bench.stop();
+
+	__bench_keep(sum);
+}
+Metasys(DirectoryScanBatch)
+{
+	static uint8_t buf[__BATCH];
+	const char *path = __directory();
+	uint64_t i, sum = 0;
+	DirectoryBatch batch;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		DirectoryDescriptor dir = DirectoryDescriptor::openinit(path);
+
+		while ((batch = dir.readbatch(buf, sizeof (buf))).empty()
+		       == false)
+			for (const DirectoryBatch::Entry &entry : batch)
+				sum += entry.d_type;
+	}
+
+	bench.stop();
+
+	__bench_keep(sum);
+}
@@ -0,0 +1,56 @@
+#include <metasys/io/Pipe.hxx>
+
+#include <unistd.h>
+
+#include <cassert>
+#include <cstdint>
+
+#include <bench.hxx>
+
+
+using metasys::Pipe;
+
+
+static constexpr size_t __CHUNK = 4096;
+
+
+// Write a chunk in a pipe and read it back from the same thread.
+//
+Libc(PipeRoundTrip)
+{
+	uint8_t buf[__CHUNK] = {};
+	int fds[2];
+	uint64_t i;
+
+	if (::pipe2(fds, O_CLOEXEC) != 0)
+		return;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		if (::write(fds[1], buf, sizeof (buf)) < 0)
+			break;
+		if (::read(fds[0], buf, sizeof (buf)) < 0)
+			break;
+	}
+
+	bench.stop();
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
+Metasys(PipeRoundTrip)
+{
+	uint8_t buf[__CHUNK] = {};
+	Pipe pipe = Pipe::openinit();
+	uint64_t i;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		pipe.wend().write(buf, sizeof (buf));
+		pipe.rend().read(buf, sizeof (buf));
+	}
+
+	bench.stop();
+}
@@ -0,0 +1,148 @@
+#include <metasys/net/TcpSocket.hxx>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include <metasys/net/InetAddress.hxx>
+
+#include <bench.hxx>
+
+
+using metasys::InetAddress;
+using metasys::TcpSocket;
+
+
+// Loopback echo server shared by both sides of the comparison so that only
+// the client code differs.
+// It accepts a single connection and echoes every byte until the client
+// closes.
+//
+struct EchoServer
+{
+	pthread_t  tid;
+	int        fd;
+	uint16_t   port;
+};
+
+static void *__echo(void *arg)
+{
+	EchoServer *server = static_cast<EchoServer *> (arg);
+	int one = 1;
+	int conn;
+	char c;
+
+	if ((conn = ::accept4(server->fd, nullptr, nullptr, SOCK_CLOEXEC)) < 0)
+		return nullptr;
+
+	::setsockopt(conn, IPPROTO_TCP, TCP_NODELAY, &one, sizeof (one));
+
+	while (::read(conn, &c, 1) == 1)
+		if (::write(conn, &c, 1) != 1)
+			break;
+
+	::close(conn);
+
+	return nullptr;
+}
+
+static bool __echo_start(EchoServer *server)
+{
+	struct sockaddr_in sin = {};
+	socklen_t slen = sizeof (sin);
+
+	sin.sin_family = AF_INET;
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	server->fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	if (server->fd < 0)
+		return false;
+
+	if ((::bind(server->fd, (struct sockaddr *) &sin, sizeof (sin)) < 0) ||
+	    (::getsockname(server->fd, (struct sockaddr *) &sin, &slen) < 0) ||
+	    (::listen(server->fd, 1) < 0) ||
+	    (::pthread_create(&server->tid, nullptr, __echo, server) != 0)) {
+		::close(server->fd);
+		return false;
+	}
+
+	server->port = ntohs(sin.sin_port);
+
+	return true;
+}
+
+static void __echo_stop(EchoServer *server)
+{
+	::pthread_join(server->tid, nullptr);
+	::close(server->fd);
+}
+
+
+// Send one byte to the echo server and wait for it to come back.
+//
+Libc(TcpPingPong)
+{
+	struct sockaddr_in sin = {};
+	EchoServer server;
+	int one = 1;
+	uint64_t i;
+	char c = 0;
+	int fd;
+
+	if (__echo_start(&server) == false)
+		return;
+
+	sin.sin_family = AF_INET;
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	sin.sin_port = htons(server.port);
+
+	fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	::connect(fd, (struct sockaddr *) &sin, sizeof (sin));
+	::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof (one));
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		if (::write(fd, &c, 1) != 1)
+			break;
+		if (::read(fd, &c, 1) != 1)
+			break;
+	}
+
+	bench.stop();
+
+	::close(fd);
+	__echo_stop(&server);
+}
+Metasys(TcpPingPong)
+{
+	EchoServer server;
+	uint64_t i;
+	char c = 0;
+
+	if (__echo_start(&server) == false)
+		return;
+
+	{
+		TcpSocket sock = TcpSocket::connectinit
+			(InetAddress::localhost(server.port));
+
+		sock.setnodelay(true);
+
+		bench.start();
+
+		for (i = 0; i < bench.iterations(); i++) {
+			sock.write(&c, 1);
+			sock.read(&c, 1);
+		}
+
+		bench.stop();
+	}
+
+	__echo_stop(&server);
+}
@@ -0,0 +1,45 @@
+#include <metasys/net/bit.hxx>
+
+#include <arpa/inet.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <bench.hxx>
+
+
+static constexpr size_t __COUNT = 4096;
+
+
+// Convert an array of integers to network byte order.
+//
+Libc(HtonBulk32)
+{
+	std::vector<uint32_t> src(__COUNT, 0x01020304), dest(__COUNT);
+	uint64_t i;
+	size_t j;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		for (j = 0; j < __COUNT; j++)
+			dest[j] = htonl(src[j]);
+		__bench_keep(dest[0]);
+	}
+
+	bench.stop();
+}
+Metasys(HtonBulk32)
+{
+	std::vector<uint32_t> src(__COUNT, 0x01020304), dest(__COUNT);
+	uint64_t i;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		metasys::hton(src, dest);
+		__bench_keep(dest[0]);
+	}
+
+	bench.stop();
+}
@@ -0,0 +1,116 @@
+#include <metasys/sched/EpollDescriptor.hxx>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <bench.hxx>
+
+
+using metasys::EpollDescriptor;
+using metasys::EpollEvent;
+
+
+static constexpr uint32_t __MAXEVENTS = 64;
+
+
+// Set of `n` always readable event file descriptors.
+// With level triggered notifications, every wait returns at once with
+// `min(n, __MAXEVENTS)` ready descriptors to dispatch.
+//
+static std::vector<int> __ready_fds(size_t n)
+{
+	std::vector<int> fds;
+	size_t i;
+	int fd;
+
+	for (i = 0; i < n; i++) {
+		if ((fd = ::eventfd(1, EFD_CLOEXEC)) < 0)
+			break;
+		fds.push_back(fd);
+	}
+
+	return fds;
+}
+
+static void __close_fds(const std::vector<int> &fds)
+{
+	for (int fd : fds)
+		::close(fd);
+}
+
+
+template<size_t N>
+static void __wait_libc(Bench &bench)
+{
+	std::vector<int> fds = __ready_fds(N);
+	struct epoll_event events[__MAXEVENTS];
+	struct epoll_event ev;
+	uint64_t i, sum = 0;
+	int efd, n, j;
+
+	if ((efd = ::epoll_create1(EPOLL_CLOEXEC)) < 0)
+		return;
+
+	for (int fd : fds) {
+		ev.events = EPOLLIN;
+		ev.data.u64 = fd;
+		::epoll_ctl(efd, EPOLL_CTL_ADD, fd, &ev);
+	}
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		if ((n = ::epoll_wait(efd, events, __MAXEVENTS, 0)) < 0)
+			break;
+		for (j = 0; j < n; j++)
+			sum += events[j].data.u64;
+	}
+
+	bench.stop();
+
+	__bench_keep(sum);
+
+	::close(efd);
+	__close_fds(fds);
+}
+
+template<size_t N>
+static void __wait_metasys(Bench &bench)
+{
+	std::vector<int> fds = __ready_fds(N);
+	EpollEvent<uint64_t> events[__MAXEVENTS];
+	EpollDescriptor epoll = EpollDescriptor::createinit();
+	uint64_t i, sum = 0;
+	size_t j, n;
+
+	for (int fd : fds)
+		epoll.add(fd, EpollEvent<uint64_t>(EPOLLIN, fd));
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		n = epoll.wait(events, __MAXEVENTS, 0);
+		for (j = 0; j < n; j++)
+			sum += events[j].data();
+	}
+
+	bench.stop();
+
+	__bench_keep(sum);
+
+	__close_fds(fds);
+}
+
+
+Libc(EpollWait1)      { __wait_libc<1>(bench); }
+Metasys(EpollWait1)   { __wait_metasys<1>(bench); }
+
+Libc(EpollWait64)     { __wait_libc<64>(bench); }
+Metasys(EpollWait64)  { __wait_metasys<64>(bench); }
+
+Libc(EpollWait512)    { __wait_libc<512>(bench); }
+Metasys(EpollWait512) { __wait_metasys<512>(bench); }
@@ -0,0 +1,48 @@
+#include <metasys/sched/Process.hxx>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include <bench.hxx>
+
+
+using metasys::Process;
+
+
+Libc(ProcessForkWait)
+{
+	uint64_t i;
+	pid_t pid;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		if ((pid = ::fork()) < 0)
+			break;
+		if (pid == 0)
+			::_exit(0);
+		::waitpid(pid, nullptr, 0);
+	}
+
+	bench.stop();
+}
+Metasys(ProcessForkWait)
+{
+	uint64_t i;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		Process proc = Process<>::forkinit();
+
+		if (proc.pid() == 0)
+			::_exit(0);
+
+		proc.wait();
+	}
+
+	bench.stop();
+}
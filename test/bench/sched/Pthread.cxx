@@ -0,0 +1,49 @@
+#include <metasys/sched/Pthread.hxx>
+
+#include <pthread.h>
+
+#include <cstdint>
+
+#include <bench.hxx>
+
+
+using metasys::Pthread;
+using metasys::PthreadBehavior;
+
+
+static void *__routine(void *)
+{
+	return nullptr;
+}
+
+
+Libc(PthreadCreateJoin)
+{
+	pthread_t tid;
+	uint64_t i;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		if (::pthread_create(&tid, nullptr, __routine, nullptr) != 0)
+			break;
+		::pthread_join(tid, nullptr);
+	}
+
+	bench.stop();
+}
+Metasys(PthreadCreateJoin)
+{
+	uint64_t i;
+
+	bench.start();
+
+	for (i = 0; i < bench.iterations(); i++) {
+		Pthread<void *, PthreadBehavior::Nothing> thread;
+
+		thread.create(__routine, nullptr);
+		thread.join();
+	}
+
+	bench.stop();
+}
@@ -0,0 +1,151 @@
+#include <metasys/fs/DirectReader.hxx>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <metasys/fs/AlignedBufferPool.hxx>
+#include <metasys/fs/File.hxx>
+
+
+using metasys::AlignedBufferPool;
+using metasys::DirectReader;
+using metasys::File;
+using std::string;
+using std::vector;
+
+
+// Create an unnamed file of `len` 32-bit words with increasing values and
+// reopen it for direct I/O if the filesystem supports it.
+//
+static File __make_file(size_t len)
+{
+	File f = File::openinit("/tmp", O_RDWR | File::TMPFILE, 0600);
+	string path = "/proc/self/fd/" + std::to_string(f.value());
+	File ret;
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		f.write(&i, sizeof (i));
+
+	if (ret.open(path, O_RDONLY | File::DIRECT, 0, [](int r) {
+		return r;
+	}) < 0)
+		ret.open(path, O_RDONLY);
+
+	return ret;
+}
+
+static void __check_read(DirectReader &reader, size_t len, size_t chunk)
+{
+	vector<uint32_t> buf(chunk);
+	size_t i, n, done = 0;
+
+	while ((n = reader.read(buf.data(), chunk * sizeof (uint32_t))) > 0) {
+		ASSERT_EQ(n % sizeof (uint32_t), 0);
+
+		for (i = 0; i < (n / sizeof (uint32_t)); i++)
+			ASSERT_EQ(buf[i], done + i);
+
+		done += n / sizeof (uint32_t);
+	}
+
+	EXPECT_EQ(done, len);
+	EXPECT_EQ(reader.read(buf.data(), chunk), 0);
+}
+
+
+TEST(AlignedBufferPool, Acquire)
+{
+	AlignedBufferPool pool = AlignedBufferPool(1000, 3, 512);
+	void *a, *b, *c;
+
+	EXPECT_EQ(pool.bufsize(), 1024);
+	EXPECT_EQ(pool.count(), 3);
+
+	a = pool.acquire();
+	b = pool.acquire();
+	c = pool.acquire();
+
+	EXPECT_EQ(reinterpret_cast<uintptr_t> (a) % 512, 0);
+	EXPECT_EQ(reinterpret_cast<uintptr_t> (b) % 512, 0);
+	EXPECT_EQ(reinterpret_cast<uintptr_t> (c) % 512, 0);
+	EXPECT_EQ(pool.acquire(), nullptr);
+
+	pool.release(b);
+	EXPECT_EQ(pool.available(), 1);
+	EXPECT_EQ(pool.acquire(), b);
+
+	pool.release(a);
+	pool.release(b);
+	pool.release(c);
+}
+
+TEST(AlignedBufferPool, Alignment)
+{
+	File f = File::openinit("/tmp", O_RDWR | File::TMPFILE, 0600);
+	size_t align = AlignedBufferPool::alignment(f);
+
+	EXPECT_GT(align, 0);
+	EXPECT_EQ(align & (align - 1), 0);
+}
+
+TEST(DirectReader, Sequential)
+{
+	File f = __make_file(100000);
+	AlignedBufferPool pool = AlignedBufferPool(
+		16384, 2, AlignedBufferPool::alignment(f));
+	DirectReader reader;
+
+	reader.start(f, pool);
+	EXPECT_EQ(pool.available(), 0);
+
+	__check_read(reader, 100000, 1000);
+
+	reader.stop();
+	EXPECT_EQ(pool.available(), 2);
+}
+
+TEST(DirectReader, ExactBlocks)
+{
+	File f = __make_file(4096);
+	AlignedBufferPool pool = AlignedBufferPool(4096, 2, 4096);
+	DirectReader reader;
+
+	reader.start(f, pool);
+	__check_read(reader, 4096, 4096);
+}
+
+TEST(DirectReader, EarlyStop)
+{
+	File f = __make_file(1 << 16);
+	AlignedBufferPool pool = AlignedBufferPool(4096, 2, 4096);
+	DirectReader reader;
+	uint32_t v;
+
+	reader.start(f, pool);
+
+	EXPECT_EQ(reader.read(&v, sizeof (v)), sizeof (v));
+	EXPECT_EQ(v, 0);
+
+	reader.stop();
+	EXPECT_EQ(pool.available(), 2);
+}
+
+TEST(DirectReader, PoolExhausted)
+{
+	File f = __make_file(16);
+	AlignedBufferPool pool = AlignedBufferPool(4096, 1, 4096);
+	DirectReader reader;
+
+	EXPECT_LT(reader.start(f, pool, 0, [](int r) { return r; }), 0);
+	EXPECT_EQ(errno, ENOBUFS);
+	EXPECT_FALSE(reader.valid());
+	EXPECT_EQ(pool.available(), 1);
+}
@@ -0,0 +1,89 @@
+#include <metasys/fs/Directory.hxx>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+
+using metasys::Directory;
+using std::set;
+using std::string;
+
+
+static string __make_tree(size_t nfiles)
+{
+	char path[] = "/tmp/metasys-test-XXXXXX";
+	size_t i;
+	int fd;
+
+	assert(::mkdtemp(path) != NULL);
+
+	for (i = 0; i < nfiles; i++) {
+		string name = string(path) + "/" + std::to_string(i);
+
+		fd = ::open(name.c_str(), O_CREAT | O_WRONLY, 0644);
+		assert(fd >= 0);
+		::close(fd);
+	}
+
+	return path;
+}
+
+static void __remove_tree(const string &path, size_t nfiles)
+{
+	size_t i;
+
+	for (i = 0; i < nfiles; i++)
+		::unlink((path + "/" + std::to_string(i)).c_str());
+
+	::rmdir(path.c_str());
+}
+
+
+TEST(Directory, Unassigned)
+{
+	Directory dir;
+
+	EXPECT_FALSE(dir.valid());
+}
+
+TEST(Directory, Open)
+{
+	string path = __make_tree(0);
+
+	{
+		Directory dir = Directory(path);
+
+		EXPECT_TRUE(dir.valid());
+	}
+
+	__remove_tree(path, 0);
+}
+
+TEST(Directory, RangeFor)
+{
+	string path = __make_tree(16);
+	set<string> names;
+	size_t i;
+
+	{
+		Directory dir = Directory(path);
+
+		for (const Directory::Entry &entry : dir)
+			names.insert(entry.d_name);
+	}
+
+	EXPECT_EQ(names.size(), 18);
+	EXPECT_TRUE(names.contains("."));
+	EXPECT_TRUE(names.contains(".."));
+
+	for (i = 0; i < 16; i++)
+		EXPECT_TRUE(names.contains(std::to_string(i)));
+
+	__remove_tree(path, 16);
+}
@@ -0,0 +1,140 @@
+#include <metasys/fs/DirectoryDescriptor.hxx>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+
+using metasys::DirectoryBatch;
+using metasys::DirectoryDescriptor;
+using std::set;
+using std::string;
+
+
+static inline bool __fd_is_valid(int fd)
+{
+	return (::fcntl(fd, F_GETFD) >= 0);
+}
+
+static string __make_tree(size_t nfiles)
+{
+	char path[] = "/tmp/metasys-test-XXXXXX";
+	size_t i;
+	int fd;
+
+	assert(::mkdtemp(path) != NULL);
+
+	for (i = 0; i < nfiles; i++) {
+		string name = string(path) + "/" + std::to_string(i);
+
+		fd = ::open(name.c_str(), O_CREAT | O_WRONLY, 0644);
+		assert(fd >= 0);
+		::close(fd);
+	}
+
+	assert(::mkdir((string(path) + "/sub").c_str(), 0755) == 0);
+
+	return path;
+}
+
+static void __remove_tree(const string &path, size_t nfiles)
+{
+	size_t i;
+
+	for (i = 0; i < nfiles; i++)
+		::unlink((path + "/" + std::to_string(i)).c_str());
+
+	::rmdir((path + "/sub").c_str());
+	::rmdir(path.c_str());
+}
+
+
+TEST(DirectoryDescriptor, OpenInit)
+{
+	string path = __make_tree(0);
+	int sysfd;
+
+	{
+		DirectoryDescriptor dir = DirectoryDescriptor::openinit(path);
+
+		EXPECT_TRUE(dir.valid());
+
+		sysfd = dir.value();
+
+		EXPECT_TRUE(__fd_is_valid(sysfd));
+		EXPECT_TRUE(::fcntl(sysfd, F_GETFD) & FD_CLOEXEC);
+	}
+
+	EXPECT_FALSE(__fd_is_valid(sysfd));
+
+	__remove_tree(path, 0);
+}
+
+TEST(DirectoryDescriptor, OpenNotDirectory)
+{
+	DirectoryDescriptor dir;
+
+	EXPECT_LT(dir.open("/dev/null", [](int ret) { return ret; }), 0);
+	EXPECT_EQ(errno, ENOTDIR);
+}
+
+TEST(DirectoryDescriptor, ReadBatches)
+{
+	string path = __make_tree(256);
+	alignas(8) char buf[1024];
+	set<string> names;
+	size_t nbatch = 0;
+
+	{
+		DirectoryDescriptor dir = DirectoryDescriptor::openinit(path);
+		DirectoryBatch batch;
+
+		while (!(batch = dir.readbatch(buf, sizeof (buf))).empty()) {
+			for (const DirectoryBatch::Entry &entry : batch) {
+				names.insert(entry.d_name);
+
+				if (string(entry.d_name) == "sub") {
+					EXPECT_EQ(entry.d_type, DT_DIR);
+				}
+			}
+
+			nbatch += 1;
+		}
+	}
+
+	EXPECT_GT(nbatch, 1);
+	EXPECT_EQ(names.size(), 256 + 3);
+	EXPECT_TRUE(names.contains("sub"));
+	EXPECT_TRUE(names.contains("255"));
+
+	__remove_tree(path, 256);
+}
+
+TEST(DirectoryDescriptor, Rewind)
+{
+	string path = __make_tree(4);
+	alignas(8) char buf[4096];
+	size_t first, second;
+
+	{
+		DirectoryDescriptor dir = DirectoryDescriptor::openinit(path);
+
+		first = dir.read(buf, sizeof (buf));
+		EXPECT_EQ(dir.read(buf, sizeof (buf)), 0);
+
+		dir.rewind();
+
+		second = dir.read(buf, sizeof (buf));
+	}
+
+	EXPECT_GT(first, 0);
+	EXPECT_EQ(first, second);
+
+	__remove_tree(path, 4);
+}
@@ -0,0 +1,230 @@
+#include <metasys/fs/DirectoryWalker.hxx>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <metasys/fs/Stat.hxx>
+
+
+using metasys::DirectoryWalker;
+using metasys::Stat;
+using std::atomic;
+using std::string;
+
+
+// Build a tree of `depth` levels, each directory holding `width`
+// subdirectories and `width` regular files.
+//
+static void __make_level(const string &path, size_t depth, size_t width,
+			 size_t *count)
+{
+	size_t i;
+	int fd;
+
+	for (i = 0; i < width; i++) {
+		string name = path + "/f" + std::to_string(i);
+
+		fd = ::open(name.c_str(), O_CREAT | O_WRONLY, 0644);
+		assert(fd >= 0);
+		::close(fd);
+
+		*count += 1;
+	}
+
+	if (depth == 0)
+		return;
+
+	for (i = 0; i < width; i++) {
+		string name = path + "/d" + std::to_string(i);
+
+		assert(::mkdir(name.c_str(), 0755) == 0);
+		*count += 1;
+
+		__make_level(name, depth - 1, width, count);
+	}
+}
+
+static string __make_tree(size_t depth, size_t width, size_t *count)
+{
+	char path[] = "/tmp/metasys-test-XXXXXX";
+
+	assert(::mkdtemp(path) != NULL);
+
+	*count = 0;
+	__make_level(path, depth, width, count);
+
+	return path;
+}
+
+static void __remove_tree(const string &path)
+{
+	string cmd = "rm -rf '" + path + "'";
+
+	assert(::system(cmd.c_str()) == 0);
+}
+
+
+TEST(DirectoryWalker, Sequential)
+{
+	size_t expected;
+	string path = __make_tree(3, 3, &expected);
+	size_t count = 0;
+
+	DirectoryWalker walker = DirectoryWalker(
+		[&count](int, const char *, const Stat &) {
+			count += 1;
+		});
+
+	walker.walk(path);
+
+	EXPECT_EQ(count, expected);
+
+	__remove_tree(path);
+}
+
+TEST(DirectoryWalker, Parallel)
+{
+	size_t expected;
+	string path = __make_tree(4, 4, &expected);
+	atomic<size_t> files = 0, dirs = 0;
+
+	DirectoryWalker walker = DirectoryWalker(
+		[&](int, const char *, const Stat &st) {
+			if (S_ISDIR(st.st_mode))
+				dirs += 1;
+			else
+				files += 1;
+		}, 4);
+
+	walker.walk(path);
+
+	EXPECT_EQ(files + dirs, expected);
+	EXPECT_EQ(dirs, 4 + 16 + 64 + 256);
+
+	walker.walk(path);
+
+	EXPECT_EQ(files + dirs, 2 * expected);
+
+	__remove_tree(path);
+}
+
+TEST(DirectoryWalker, Prune)
+{
+	size_t expected;
+	string path = __make_tree(1, 2, &expected);
+	atomic<size_t> count = 0;
+
+	DirectoryWalker walker = DirectoryWalker(
+		[&count](int, const char *name, const Stat &) {
+			count += 1;
+			return (string(name) != "d0");
+		}, 2);
+
+	walker.walk(path);
+
+	// The 2 files in "d0" are skipped.
+	EXPECT_EQ(count, expected - 2);
+
+	__remove_tree(path);
+}
+
+TEST(DirectoryWalker, NoFollow)
+{
+	size_t expected;
+	string path = __make_tree(1, 1, &expected);
+	size_t links = 0, count = 0;
+
+	ASSERT_EQ(::symlink("d0", (path + "/link").c_str()), 0);
+
+	DirectoryWalker walker = DirectoryWalker(
+		[&](int dirfd, const char *name, const Stat &st) {
+			Stat follow = Stat(dirfd, name, 0);
+
+			if (S_ISLNK(st.st_mode)) {
+				EXPECT_TRUE(S_ISDIR(follow.st_mode));
+				links += 1;
+			}
+
+			count += 1;
+		});
+
+	walker.walk(path);
+
+	EXPECT_EQ(links, 1);
+	EXPECT_EQ(count, expected + 1);
+
+	__remove_tree(path);
+}
+
+TEST(DirectoryWalker, VisitorThrows)
+{
+	size_t expected;
+	string path = __make_tree(3, 3, &expected);
+	atomic<bool> fail = true;
+	atomic<size_t> count = 0;
+
+	DirectoryWalker walker = DirectoryWalker(
+		[&](int, const char *name, const Stat &) {
+			if (fail && (string(name) == "d1"))
+				throw std::runtime_error(name);
+			count += 1;
+		}, 4);
+
+	EXPECT_THROW(walker.walk(path), std::runtime_error);
+
+	fail = false;
+	count = 0;
+
+	walker.walk(path);
+
+	EXPECT_EQ(count, expected);
+
+	__remove_tree(path);
+}
+
+TEST(DirectoryWalker, RemovedEntries)
+{
+	size_t expected;
+	string path = __make_tree(0, 64, &expected);
+	size_t count = 0;
+
+	// The first visit removes all the other files while the walk goes.
+	DirectoryWalker walker = DirectoryWalker(
+		[&](int dirfd, const char *name, const Stat &) {
+			size_t i;
+
+			if (count++ > 0)
+				return;
+
+			for (i = 0; i < expected; i++) {
+				string other = "f" + std::to_string(i);
+
+				if (other != name)
+					::unlinkat(dirfd, other.c_str(), 0);
+			}
+		});
+
+	EXPECT_EQ(walker.walk(path, [](int ret) { return ret; }), 0);
+	EXPECT_GE(count, 1);
+
+	__remove_tree(path);
+}
+
+TEST(DirectoryWalker, RootNotFound)
+{
+	DirectoryWalker walker = DirectoryWalker(
+		[](int, const char *, const Stat &) {});
+
+	EXPECT_LT(walker.walk("/nonexistent/metasys", [](int ret) {
+		return ret;
+	}), 0);
+	EXPECT_EQ(errno, ENOENT);
+}
@@ -0,0 +1,135 @@
+#include <metasys/fs/File.hxx>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <metasys/fs/Stat.hxx>
+#include <metasys/sys/ErrnoException.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+using metasys::ErrnoException;
+using metasys::File;
+using metasys::Stat;
+using metasys::SystemException;
+using std::string;
+
+
+TEST(File, Default)
+{
+	File f;
+
+	EXPECT_FALSE(f.valid());
+}
+
+TEST(File, OpenNotFound)
+{
+	File f;
+
+	EXPECT_LT(f.open("/nonexistent/metasys", O_RDONLY, 0, [](int r) {
+		return r;
+	}), 0);
+	EXPECT_EQ(errno, ENOENT);
+	EXPECT_FALSE(f.valid());
+
+	EXPECT_THROW(File::openinit("/nonexistent/metasys", O_RDONLY),
+		     SystemException);
+}
+
+TEST(File, OpenExisting)
+{
+	File f;
+
+	EXPECT_LT(f.open("/dev/null", O_CREAT | O_EXCL | O_WRONLY, 0600,
+			 [](int r) { return r; }), 0);
+	EXPECT_EQ(errno, EEXIST);
+
+	EXPECT_THROW(File::openinit("/dev/null", O_CREAT | O_EXCL | O_WRONLY),
+		     ErrnoException<EEXIST>);
+	EXPECT_THROW(File::openinit("/", O_WRONLY), ErrnoException<EISDIR>);
+}
+
+TEST(File, CloseOnExec)
+{
+	File f = File::openinit("/dev/null", O_RDONLY);
+
+	ASSERT_TRUE(f.valid());
+	EXPECT_TRUE(::fcntl(f.value(), F_GETFD) & FD_CLOEXEC);
+}
+
+TEST(File, Positional)
+{
+	File f = File::openinit("/tmp", O_RDWR | File::TMPFILE, 0600);
+	char buf[6] = { 0 };
+
+	f.allocate(0, 1 << 16);
+	EXPECT_EQ(Stat(f.value(), "", Stat::EMPTY_PATH).st_size, 1 << 16);
+
+	EXPECT_EQ(f.pwrite("world", 5, 100), 5);
+	EXPECT_EQ(f.pwrite("hello", 5, 0), 5);
+
+	EXPECT_EQ(f.pread(buf, 5, 100), 5);
+	EXPECT_STREQ(buf, "world");
+
+	// Positional I/O leaves the file offset untouched.
+	EXPECT_EQ(f.read(buf, 5), 5);
+	EXPECT_STREQ(buf, "hello");
+
+	f.datasync();
+}
+
+TEST(File, ConcurrentPread)
+{
+	File f = File::openinit("/tmp", O_RDWR | File::TMPFILE, 0600);
+	std::vector<std::thread> threads;
+	uint32_t i, value;
+
+	for (i = 0; i < 1024; i++)
+		f.pwrite(&i, sizeof (i), i * sizeof (i));
+
+	f.advise(POSIX_FADV_RANDOM);
+	f.readahead(0, 1024 * sizeof (i));
+
+	for (i = 0; i < 4; i++) {
+		threads.emplace_back([&f, i]() {
+			uint32_t j, v;
+
+			for (j = i; j < 1024; j += 4) {
+				f.pread(&v, sizeof (v), j * sizeof (v));
+				EXPECT_EQ(v, j);
+			}
+		});
+	}
+
+	for (std::thread &t : threads)
+		t.join();
+
+	EXPECT_EQ(f.pread(&value, sizeof (value), 1024 * sizeof (value)), 0);
+}
+
+TEST(File, OpenAt)
+{
+	char path[] = "/tmp/metasys-test-XXXXXX";
+	File dir, f;
+
+	ASSERT_NE(::mkdtemp(path), nullptr);
+
+	dir.open(path, O_RDONLY | O_DIRECTORY);
+	f.open(dir, "file", O_WRONLY | O_CREAT | O_EXCL, 0600);
+
+	EXPECT_EQ(f.write("abc", 3), 3);
+	EXPECT_EQ(Stat(dir, "file", 0).st_size, 3);
+
+	::unlinkat(dir.value(), "file", 0);
+	::rmdir(path);
+}
@@ -0,0 +1,89 @@
+#include <metasys/fs/Statx.hxx>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <metasys/sys/SystemException.hxx>
+
+
+using metasys::Statx;
+using metasys::SystemException;
+using std::string;
+
+
+template<typename T>
+concept HasSize = requires (const T &st) { st.size(); };
+
+template<typename T>
+concept HasMtime = requires (const T &st) { st.mtime(); };
+
+
+TEST(Statx, MaskedAccessors)
+{
+	using SizeOnly = Statx<STATX_SIZE>;
+	using Basic = Statx<>;
+
+	EXPECT_TRUE(HasSize<SizeOnly>);
+	EXPECT_FALSE(HasMtime<SizeOnly>);
+	EXPECT_TRUE(HasSize<Basic>);
+	EXPECT_TRUE(HasMtime<Basic>);
+}
+
+TEST(Statx, Size)
+{
+	char path[] = "/tmp/metasys-test-XXXXXX";
+	int fd = ::mkstemp(path);
+
+	ASSERT_GE(fd, 0);
+	ASSERT_EQ(::write(fd, "hello", 5), 5);
+
+	Statx<STATX_SIZE> byfd = Statx<STATX_SIZE>(fd);
+	Statx<STATX_SIZE> bypath = Statx<STATX_SIZE>(AT_FDCWD, path,
+		Statx<STATX_SIZE>::DONT_SYNC);
+
+	EXPECT_TRUE(byfd.has(STATX_SIZE));
+	EXPECT_EQ(byfd.size(), 5);
+	EXPECT_EQ(bypath.size(), 5);
+
+	::close(fd);
+	::unlink(path);
+}
+
+TEST(Statx, NoFollow)
+{
+	Statx<STATX_TYPE> st;
+
+	st.scan(AT_FDCWD, "/proc/self", Statx<STATX_TYPE>::SYMLINK_NOFOLLOW);
+	EXPECT_TRUE(S_ISLNK(st.mode()));
+
+	st.scan("/proc/self");
+	EXPECT_TRUE(S_ISDIR(st.mode()));
+}
+
+TEST(Statx, BirthTime)
+{
+	Statx<STATX_BTIME | STATX_MTIME> st = Statx<STATX_BTIME | STATX_MTIME>(
+		string("/tmp"));
+
+	if (st.has(STATX_BTIME) == false)
+		GTEST_SKIP() << "filesystem does not report birth time";
+
+	EXPECT_LE(st.btime().tv_sec, st.mtime().tv_sec);
+}
+
+TEST(Statx, NotFound)
+{
+	EXPECT_LT(Statx<STATX_SIZE>().scan("/nonexistent/metasys", [](int r) {
+		return r;
+	}), 0);
+	EXPECT_EQ(errno, ENOENT);
+
+	EXPECT_THROW(Statx<STATX_SIZE>("/nonexistent/metasys"),
+		     SystemException);
+}
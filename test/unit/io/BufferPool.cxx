@@ -0,0 +1,172 @@
+#include <metasys/io/BufferPool.hxx>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <metasys/io/ReadableDescriptor.hxx>
+#include <metasys/io/ReceiveBuffer.hxx>
+
+
+using metasys::BufferPool;
+using metasys::ReadableDescriptor;
+using metasys::ReceiveBuffer;
+using std::string;
+using std::vector;
+
+
+TEST(BufferPool, AcquireAll)
+{
+	BufferPool pool = BufferPool(4096, 8);
+	std::set<void *> seen;
+	void *buf;
+	size_t i;
+
+	for (i = 0; i < 8; i++) {
+		ASSERT_NE(buf = pool.acquire(), nullptr);
+		EXPECT_EQ(reinterpret_cast<uintptr_t> (buf) % 4096, 0);
+		seen.insert(buf);
+	}
+
+	EXPECT_EQ(seen.size(), 8);
+	EXPECT_EQ(pool.acquire(), nullptr);
+
+	for (void *b : seen)
+		pool.release(b);
+
+	EXPECT_NE(pool.acquire(), nullptr);
+}
+
+TEST(BufferPool, Cache)
+{
+	BufferPool pool = BufferPool(64, 16);
+
+	{
+		BufferPool::Cache cache = BufferPool::Cache(pool, 8);
+		void *bufs[16];
+		size_t i;
+
+		for (i = 0; i < 16; i++)
+			ASSERT_NE(bufs[i] = cache.acquire(), nullptr);
+
+		EXPECT_EQ(cache.acquire(), nullptr);
+
+		for (i = 0; i < 16; i++)
+			cache.release(bufs[i]);
+
+		EXPECT_LE(cache.size(), 8);
+	}
+
+	// The cache gave everything back on destruction.
+	BufferPool::Cache other = BufferPool::Cache(pool, 32);
+
+	for (size_t i = 0; i < 16; i++)
+		EXPECT_NE(other.acquire(), nullptr);
+}
+
+TEST(BufferPool, Concurrent)
+{
+	BufferPool pool = BufferPool(64, 256);
+	vector<std::thread> threads;
+	size_t t;
+
+	for (t = 0; t < 8; t++) {
+		threads.emplace_back([&pool, t]() {
+			BufferPool::Cache cache = BufferPool::Cache(pool, 8);
+			uint64_t *held[24];
+			size_t i, j;
+
+			for (i = 0; i < 2000; i++) {
+				for (j = 0; j < 24; j++) {
+					held[j] = static_cast<uint64_t *>
+						(cache.acquire());
+					ASSERT_NE(held[j], nullptr);
+					*held[j] = t;
+				}
+
+				for (j = 0; j < 24; j++) {
+					ASSERT_EQ(*held[j], t);
+					cache.release(held[j]);
+				}
+			}
+		});
+	}
+
+	for (std::thread &thread : threads)
+		thread.join();
+
+	for (t = 0; t < 256; t++)
+		EXPECT_NE(pool.acquire(), nullptr);
+	EXPECT_EQ(pool.acquire(), nullptr);
+}
+
+TEST(ReceiveBuffer, HoldOnlyWhilePending)
+{
+	BufferPool pool = BufferPool(16, 4);
+	BufferPool::Cache cache = BufferPool::Cache(pool, 4);
+	ReceiveBuffer rbuf = ReceiveBuffer(cache);
+	auto passthrough = [](ssize_t r) { return r; };
+	int fds[2];
+
+	ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds),
+		  0);
+
+	ReadableDescriptor sock = ReadableDescriptor(fds[0]);
+
+	EXPECT_EQ(rbuf.receive(sock, passthrough), -1);
+	EXPECT_EQ(errno, EAGAIN);
+	EXPECT_FALSE(rbuf.holding());
+
+	ASSERT_EQ(::write(fds[1], "hello world", 11), 11);
+
+	EXPECT_EQ(rbuf.receive(sock, passthrough), 11);
+	EXPECT_TRUE(rbuf.holding());
+	EXPECT_EQ(string(rbuf.data().begin(), rbuf.data().end()),
+		  "hello world");
+
+	rbuf.consume(6);
+	EXPECT_TRUE(rbuf.holding());
+
+	// Compact to make room once the end of the buffer is reached.
+	ASSERT_EQ(::write(fds[1], "0123456789", 10), 10);
+	EXPECT_EQ(rbuf.receive(sock, passthrough), 5);
+	EXPECT_EQ(rbuf.receive(sock, passthrough), 5);
+	EXPECT_EQ(string(rbuf.data().begin(), rbuf.data().end()),
+		  "world0123456789");
+
+	rbuf.consume(rbuf.data().size());
+	EXPECT_FALSE(rbuf.holding());
+	EXPECT_EQ(cache.size(), 2);
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+TEST(ReceiveBuffer, ConsumeIdle)
+{
+	BufferPool pool = BufferPool(16, 4);
+	BufferPool::Cache cache = BufferPool::Cache(pool, 4);
+	ReceiveBuffer rbuf = ReceiveBuffer(cache);
+	size_t size = cache.size();
+	void *buf;
+
+	rbuf.consume(rbuf.data().size());
+	rbuf.consume(0);
+
+	EXPECT_FALSE(rbuf.holding());
+	EXPECT_EQ(cache.size(), size);
+
+	buf = cache.acquire();
+	EXPECT_NE(buf, nullptr);
+	cache.release(buf);
+}
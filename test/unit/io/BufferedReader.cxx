@@ -0,0 +1,169 @@
+#include <metasys/io/BufferedReader.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include <metasys/io/InputStream.hxx>
+#include <metasys/io/Pipe.hxx>
+#include <metasys/io/ReadableDescriptor.hxx>
+
+
+using metasys::BatchInputStream;
+using metasys::BufferedReader;
+using metasys::Pipe;
+using metasys::ReadableDescriptor;
+using metasys::UnitInputStream;
+using std::string;
+using std::string_view;
+
+
+// Input stream serving a string by chunks of at most `chunk` bytes and
+// counting the calls.
+//
+struct ChunkInput
+{
+	string  data;
+	size_t  chunk;
+	size_t  pos = 0;
+	size_t  calls = 0;
+
+	size_t read(void *dest, size_t len)
+	{
+		size_t n = data.size() - pos;
+
+		calls += 1;
+
+		if (n > len)
+			n = len;
+		if (n > chunk)
+			n = chunk;
+
+		std::memcpy(dest, data.data() + pos, n);
+		pos += n;
+
+		return n;
+	}
+};
+
+
+TEST(BufferedReader, Concepts)
+{
+	using Reader = BufferedReader<ReadableDescriptor>;
+
+	EXPECT_TRUE(UnitInputStream<Reader>);
+	EXPECT_TRUE(BatchInputStream<Reader>);
+}
+
+TEST(BufferedReader, UnitRead)
+{
+	BufferedReader<ChunkInput, 16> reader(ChunkInput { "abcdef", 64 });
+
+	EXPECT_EQ(reader.peek(), 'a');
+	EXPECT_EQ(reader.read(), 'a');
+	EXPECT_EQ(reader.read(), 'b');
+	EXPECT_EQ(reader.available(), 4);
+	EXPECT_EQ(reader.stream().calls, 1);
+
+	EXPECT_EQ(reader.read(), 'c');
+	EXPECT_EQ(reader.read(), 'd');
+	EXPECT_EQ(reader.read(), 'e');
+	EXPECT_EQ(reader.read(), 'f');
+	EXPECT_EQ(reader.read(), -1);
+	EXPECT_EQ(reader.peek(), -1);
+}
+
+TEST(BufferedReader, BatchBypass)
+{
+	BufferedReader<ChunkInput, 8> reader(
+		ChunkInput { string(100, 'x'), 100 });
+	char buf[64];
+
+	EXPECT_EQ(reader.read(buf, 4), 4);
+	EXPECT_EQ(reader.stream().calls, 1);
+	EXPECT_EQ(reader.available(), 4);
+
+	// Served from the buffer first, then straight from the stream.
+	EXPECT_EQ(reader.read(buf, sizeof (buf)), 4);
+	EXPECT_EQ(reader.read(buf, sizeof (buf)), 64);
+	EXPECT_EQ(reader.stream().calls, 2);
+}
+
+TEST(BufferedReader, ReadUntilView)
+{
+	BufferedReader<ChunkInput, 32> reader(
+		ChunkInput { "first\nsecond line\n\nlast", 5 });
+
+	EXPECT_EQ(reader.readuntil('\n'), "first\n");
+	EXPECT_EQ(reader.readuntil('\n'), "second line\n");
+	EXPECT_EQ(reader.readuntil('\n'), "\n");
+	EXPECT_EQ(reader.readuntil('\n'), "last");
+	EXPECT_EQ(reader.readuntil('\n'), "");
+}
+
+TEST(BufferedReader, ReadUntilSet)
+{
+	BufferedReader<ChunkInput, 32> reader(
+		ChunkInput { string("a,b;c\0d", 7), 2 });
+
+	EXPECT_EQ(reader.readuntil(",;"), "a,");
+	EXPECT_EQ(reader.readuntil(",;"), "b;");
+	EXPECT_EQ(reader.readuntil('\0'), string_view("c\0", 2));
+	EXPECT_EQ(reader.readuntil(",;"), "d");
+}
+
+TEST(BufferedReader, ReadLine)
+{
+	BufferedReader<ChunkInput, 32> reader(
+		ChunkInput { "unix\ndos\r\n\r\nlast", 3 });
+
+	EXPECT_EQ(reader.readline(), "unix");
+	EXPECT_EQ(reader.readline(), "dos");
+	EXPECT_EQ(reader.readline(), "");
+	EXPECT_EQ(reader.readline(), "last");
+	EXPECT_EQ(reader.readline(), "");
+}
+
+TEST(BufferedReader, ReadUntilFullBuffer)
+{
+	BufferedReader<ChunkInput, 8> reader(
+		ChunkInput { "0123456789\n", 64 });
+
+	EXPECT_EQ(reader.readuntil('\n'), "01234567");
+	EXPECT_EQ(reader.readuntil('\n'), "89\n");
+}
+
+TEST(BufferedReader, ReadUntilCopy)
+{
+	BufferedReader<ChunkInput, 4> reader(
+		ChunkInput { "key=value;rest", 3 });
+	char buf[32];
+	size_t n;
+
+	n = reader.readuntil(';', buf, sizeof (buf));
+	EXPECT_EQ(string_view(buf, n), "key=value;");
+
+	n = reader.readuntil(';', buf, 2);
+	EXPECT_EQ(string_view(buf, n), "re");
+
+	n = reader.readuntil(';', buf, sizeof (buf));
+	EXPECT_EQ(string_view(buf, n), "st");
+
+	EXPECT_EQ(reader.readuntil(';', buf, sizeof (buf)), 0);
+}
+
+TEST(BufferedReader, Pipe)
+{
+	Pipe pipe = Pipe::openinit();
+	BufferedReader<ReadableDescriptor> reader(pipe.rend());
+
+	pipe.wend().write("hello\nworld\n", 12);
+	pipe.wmove().close();
+
+	EXPECT_EQ(reader.readuntil('\n'), "hello\n");
+	EXPECT_EQ(reader.readuntil('\n'), "world\n");
+	EXPECT_EQ(reader.read(), -1);
+}
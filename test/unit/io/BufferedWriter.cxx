@@ -0,0 +1,108 @@
+#include <metasys/io/BufferedWriter.hxx>
+
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <metasys/io/OutputStream.hxx>
+#include <metasys/io/Pipe.hxx>
+#include <metasys/io/WritableDescriptor.hxx>
+
+
+using metasys::BatchOutputStream;
+using metasys::BufferedWriter;
+using metasys::Pipe;
+using metasys::UnitOutputStream;
+using metasys::WritableDescriptor;
+using std::string;
+
+
+// Output stream accepting at most `chunk` bytes per call and counting the
+// calls.
+//
+struct ChunkOutput
+{
+	string  data;
+	size_t  chunk;
+	size_t  calls = 0;
+
+	size_t write(const void *src, size_t len)
+	{
+		calls += 1;
+
+		if (len > chunk)
+			len = chunk;
+
+		data.append(static_cast<const char *> (src), len);
+
+		return len;
+	}
+};
+
+
+TEST(BufferedWriter, Concepts)
+{
+	using Writer = BufferedWriter<WritableDescriptor>;
+
+	EXPECT_TRUE(UnitOutputStream<Writer>);
+	EXPECT_TRUE(BatchOutputStream<Writer>);
+}
+
+TEST(BufferedWriter, Coalesce)
+{
+	ChunkOutput stream = { "", 1024 };
+
+	{
+		BufferedWriter<ChunkOutput &, 16> writer(stream);
+
+		writer.write('a');
+		writer.write("bcd", 3);
+		writer.write('e');
+
+		EXPECT_EQ(writer.pending(), 5);
+		EXPECT_EQ(stream.calls, 0);
+
+		writer.flush();
+
+		EXPECT_EQ(writer.pending(), 0);
+		EXPECT_EQ(stream.data, "abcde");
+		EXPECT_EQ(stream.calls, 1);
+
+		writer.write("fgh", 3);
+	}
+
+	EXPECT_EQ(stream.data, "abcdefgh");
+	EXPECT_EQ(stream.calls, 2);
+}
+
+TEST(BufferedWriter, Overflow)
+{
+	ChunkOutput stream = { "", 3 };
+	BufferedWriter<ChunkOutput &, 8> writer(stream);
+
+	writer.write("0123", 4);
+	writer.write("4567", 4);
+	EXPECT_EQ(stream.calls, 0);
+
+	writer.write('8');
+	EXPECT_EQ(stream.data, "01234567");
+
+	writer.write("abcdefghij", 10);
+	EXPECT_EQ(stream.data, "012345678abcdefghij");
+	EXPECT_EQ(writer.pending(), 0);
+}
+
+TEST(BufferedWriter, Pipe)
+{
+	Pipe pipe = Pipe::openinit();
+	BufferedWriter<WritableDescriptor> writer(pipe.wend());
+	char buf[16];
+
+	writer.write("hello ", 6);
+	writer.write("world", 5);
+	writer.flush();
+
+	EXPECT_EQ(pipe.rend().read(buf, sizeof (buf)), 11);
+	EXPECT_EQ(string(buf, 11), "hello world");
+}
@@ -0,0 +1,114 @@
+#include <metasys/io/DelimiterScanner.hxx>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+using metasys::DelimiterScanner;
+using std::string;
+using std::string_view;
+using std::vector;
+
+
+static vector<DelimiterScanner::Isa> __supported_isas()
+{
+	vector<DelimiterScanner::Isa> ret;
+
+	ret.push_back(DelimiterScanner::Isa::Scalar);
+
+#if defined(__x86_64__)
+	ret.push_back(DelimiterScanner::Isa::Sse2);
+
+	if (DelimiterScanner::isa() == DelimiterScanner::Isa::Avx2)
+		ret.push_back(DelimiterScanner::Isa::Avx2);
+#endif
+
+	return ret;
+}
+
+
+TEST(DelimiterScanner, Contains)
+{
+	DelimiterScanner scanner = DelimiterScanner(string_view("\r\n\0,", 4));
+
+	EXPECT_EQ(scanner.size(), 4);
+	EXPECT_EQ(DelimiterScanner("aab").size(), 2);
+	EXPECT_TRUE(scanner.contains('\0'));
+	EXPECT_TRUE(scanner.contains('\r'));
+	EXPECT_TRUE(scanner.contains('\n'));
+	EXPECT_TRUE(scanner.contains(','));
+	EXPECT_FALSE(scanner.contains('a'));
+}
+
+TEST(DelimiterScanner, NotFound)
+{
+	string buf(1000, 'x');
+
+	for (DelimiterScanner::Isa isa : __supported_isas()) {
+		EXPECT_EQ(DelimiterScanner('\n').find(buf.data(), buf.size(),
+						      isa), buf.size());
+		EXPECT_EQ(DelimiterScanner(",;").find(buf.data(), buf.size(),
+						      isa), buf.size());
+	}
+}
+
+TEST(DelimiterScanner, EveryPosition)
+{
+	DelimiterScanner scanners[] = {
+		DelimiterScanner('\n'),
+		DelimiterScanner(string_view("\0", 1)),
+		DelimiterScanner("\r\n"),
+		DelimiterScanner("{}[],:\""),
+		DelimiterScanner("abcdefghijkl")  // Beyond SIMD_MAX
+	};
+	string buf(100, ' ');
+	size_t pos;
+
+	for (const DelimiterScanner &scanner : scanners) {
+		for (pos = 0; pos < buf.size(); pos++) {
+			uint8_t c;
+
+			for (c = 0; scanner.contains(c) == false; c++)
+				;
+
+			buf[pos] = static_cast<char> (c);
+
+			for (DelimiterScanner::Isa isa : __supported_isas())
+				ASSERT_EQ(scanner.find(buf.data(), buf.size(),
+						       isa), pos);
+
+			EXPECT_EQ(scanner.find(buf.data() + pos + 1,
+					       buf.size() - pos - 1),
+				  buf.size() - pos - 1);
+
+			buf[pos] = ' ';
+		}
+	}
+}
+
+TEST(DelimiterScanner, Random)
+{
+	DelimiterScanner scanner = DelimiterScanner("\n\r\t,");
+	string buf(4096, '\0');
+	size_t i, expected;
+
+	std::srand(42);
+
+	for (i = 0; i < buf.size(); i++)
+		buf[i] = static_cast<char> ('a' + std::rand() % 26);
+
+	for (i = 0; i < 64; i++) {
+		expected = std::rand() % buf.size();
+		buf[expected] = ",\t\r\n"[i % 4];
+
+		for (DelimiterScanner::Isa isa : __supported_isas())
+			ASSERT_EQ(scanner.find(buf.data(), buf.size(), isa),
+				  scanner.find(buf.data(), buf.size(),
+					       DelimiterScanner::Isa::Scalar));
+	}
+}
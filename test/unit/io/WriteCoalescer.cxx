@@ -0,0 +1,208 @@
+#include <metasys/io/WriteCoalescer.hxx>
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <metasys/io/OutputStream.hxx>
+#include <metasys/io/Pipe.hxx>
+#include <metasys/io/WritableDescriptor.hxx>
+#include <metasys/net/TcpSocket.hxx>
+
+
+using metasys::BatchOutputStream;
+using metasys::Pipe;
+using metasys::TcpSocket;
+using metasys::WritableDescriptor;
+using metasys::WriteCoalescer;
+using std::string;
+
+
+static string __drain(int fd, size_t len)
+{
+	string ret(len, '\0');
+	size_t done = 0;
+	ssize_t n;
+
+	while (done < len) {
+		n = ::read(fd, ret.data() + done, len - done);
+		if (n <= 0)
+			break;
+		done += n;
+	}
+
+	ret.resize(done);
+
+	return ret;
+}
+
+
+TEST(WriteCoalescer, Concepts)
+{
+	EXPECT_TRUE(BatchOutputStream<WriteCoalescer<WritableDescriptor>>);
+}
+
+TEST(WriteCoalescer, SmallWrites)
+{
+	Pipe pipe = Pipe::openinit();
+	WriteCoalescer<WritableDescriptor, 64> out(pipe.wend());
+
+	out.write("HTTP/1.1 ", 9);
+	out.write("200 OK", 6);
+	out.write("\r\n", 2);
+
+	EXPECT_EQ(out.pending(), 17);
+
+	out.flush();
+
+	EXPECT_EQ(out.pending(), 0);
+	EXPECT_EQ(__drain(pipe.rend().value(), 17), "HTTP/1.1 200 OK\r\n");
+}
+
+TEST(WriteCoalescer, Reference)
+{
+	Pipe pipe = Pipe::openinit();
+	string body = "body";
+	WriteCoalescer<WritableDescriptor, 64> out(pipe.wend());
+
+	out.write("head:", 5);
+	out.writeref(body.data(), body.size());
+	out.write(":tail", 5);
+
+	// Not copied: the change is visible at flush time.
+	body[0] = 'B';
+
+	out.flush();
+
+	EXPECT_EQ(__drain(pipe.rend().value(), 14), "head:Body:tail");
+}
+
+TEST(WriteCoalescer, LargeWrite)
+{
+	Pipe pipe = Pipe::openinit();
+	WriteCoalescer<WritableDescriptor, 64> out(pipe.wend());
+	string large(1000, 'x');
+
+	out.write("small", 5);
+	out.write(large.data(), large.size());
+
+	// Large writes are sent immediately with the pending bytes.
+	EXPECT_EQ(out.pending(), 0);
+	EXPECT_EQ(__drain(pipe.rend().value(), 1005), "small" + large);
+}
+
+TEST(WriteCoalescer, Overflow)
+{
+	Pipe pipe = Pipe::openinit();
+	WriteCoalescer<WritableDescriptor, 16, 4> out(pipe.wend());
+	string expected;
+	size_t i;
+
+	for (i = 0; i < 100; i++) {
+		string chunk = std::to_string(i) + ",";
+
+		out.write(chunk.data(), chunk.size());
+		out.writeref(",", 1);
+		expected += chunk + ",";
+	}
+
+	out.flush();
+
+	EXPECT_EQ(__drain(pipe.rend().value(), expected.size()), expected);
+}
+
+TEST(WriteCoalescer, FlushOnDestruction)
+{
+	Pipe pipe = Pipe::openinit();
+
+	{
+		WriteCoalescer<WritableDescriptor, 64> out(pipe.wend());
+
+		out.write("pending", 7);
+	}
+
+	EXPECT_EQ(__drain(pipe.rend().value(), 7), "pending");
+}
+
+TEST(WriteCoalescer, FailedFlushDropsPending)
+{
+	Pipe pipe = Pipe::openinit();
+	string body = "body";
+	WriteCoalescer<WritableDescriptor, 64> out(pipe.wend());
+	sighandler_t old;
+
+	out.writeref(body.data(), body.size());
+
+	pipe.rend().close();
+	old = ::signal(SIGPIPE, SIG_IGN);
+
+	EXPECT_ANY_THROW(out.flush());
+	EXPECT_EQ(out.pending(), 0);
+
+	::signal(SIGPIPE, old);
+}
+
+TEST(WriteCoalescer, PartialFlush)
+{
+	Pipe pipe = Pipe::openinit(O_NONBLOCK);
+	string large(1 << 20, 'y');
+	WriteCoalescer<WritableDescriptor, 64> out(pipe.wend());
+	int ret;
+
+	out.writeref("start", 5);
+	out.writeref(large.data(), large.size());
+
+	ret = out.flush([](int r) { return r; });
+
+	EXPECT_EQ(ret, -1);
+	EXPECT_EQ(errno, EAGAIN);
+	EXPECT_GT(out.pending(), 0);
+	EXPECT_LT(out.pending(), large.size());
+
+	EXPECT_EQ(__drain(pipe.rend().value(), 5), "start");
+	EXPECT_EQ(__drain(pipe.rend().value(), 5), "yyyyy");
+}
+
+TEST(WriteCoalescer, MoreOnSocket)
+{
+	int fds[2];
+
+	ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+	{
+		WriteCoalescer<WritableDescriptor, 8> out(fds[0]);
+
+		out.setmore(true);
+		out.write("abcdef", 6);
+		out.write("ghijkl", 6);
+		out.flush();
+	}
+
+	EXPECT_EQ(__drain(fds[1], 12), "abcdefghijkl");
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+TEST(WriteCoalescer, TcpCork)
+{
+	TcpSocket sock = TcpSocket::openinit();
+	int value;
+	socklen_t len = sizeof (value);
+
+	sock.setcork(true);
+	ASSERT_EQ(::getsockopt(sock.value(), IPPROTO_TCP, TCP_CORK, &value,
+			       &len), 0);
+	EXPECT_EQ(value, 1);
+
+	sock.setcork(false);
+	sock.setnodelay(true);
+	ASSERT_EQ(::getsockopt(sock.value(), IPPROTO_TCP, TCP_NODELAY, &value,
+			       &len), 0);
+	EXPECT_EQ(value, 1);
+}
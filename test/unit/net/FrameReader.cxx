@@ -0,0 +1,176 @@
+#include <metasys/net/FrameReader.hxx>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <metasys/sys/ClosingDescriptor.hxx>
+#include <metasys/sys/ErrnoException.hxx>
+
+
+using metasys::ClosingDescriptor;
+using metasys::ErrnoException;
+using metasys::FrameReader;
+using std::string;
+
+
+struct FramePair
+{
+	int  fds[2];
+
+	FramePair()
+	{
+		[[maybe_unused]] int ret;
+
+		ret = ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds);
+		assert(ret == 0);
+	}
+
+	~FramePair()
+	{
+		if (fds[1] >= 0)
+			::close(fds[1]);
+	}
+
+	// Send a frame with a 4 bytes big-endian length.
+	//
+	void send(const string &payload) const
+	{
+		uint32_t len = static_cast<uint32_t> (payload.size());
+		uint8_t header[4] = {
+			uint8_t(len >> 24), uint8_t(len >> 16),
+			uint8_t(len >> 8), uint8_t(len)
+		};
+		[[maybe_unused]] ssize_t ret;
+
+		ret = ::write(fds[1], header, sizeof (header));
+		assert(ret == sizeof (header));
+		ret = ::write(fds[1], payload.data(), payload.size());
+		assert(ret == static_cast<ssize_t> (payload.size()));
+	}
+
+	void shutdown()
+	{
+		::close(fds[1]);
+		fds[1] = -1;
+	}
+};
+
+static string __str(std::span<const uint8_t> frame)
+{
+	return string(reinterpret_cast<const char *> (frame.data()),
+		      frame.size());
+}
+
+
+TEST(FrameReader, SeveralFramesOneFill)
+{
+	FramePair pair;
+	FrameReader<ClosingDescriptor> reader(pair.fds[0]);
+	std::span<const uint8_t> frame;
+
+	pair.send("hello");
+	pair.send("");
+	pair.send("world");
+
+	EXPECT_FALSE(reader.next(&frame));
+	EXPECT_EQ(reader.fill([](ssize_t r) { return r; }), 4 + 5 + 4 + 4 + 5);
+
+	ASSERT_TRUE(reader.next(&frame));
+	EXPECT_EQ(__str(frame), "hello");
+	ASSERT_TRUE(reader.next(&frame));
+	EXPECT_EQ(__str(frame), "");
+	ASSERT_TRUE(reader.next(&frame));
+	EXPECT_EQ(__str(frame), "world");
+	EXPECT_FALSE(reader.next(&frame));
+	EXPECT_EQ(reader.pending(), 0);
+}
+
+TEST(FrameReader, PartialFrame)
+{
+	FramePair pair;
+	FrameReader<ClosingDescriptor> reader(pair.fds[0]);
+	std::span<const uint8_t> frame;
+	[[maybe_unused]] ssize_t ret;
+
+	ret = ::write(pair.fds[1], "\0\0\0\5he", 6);
+	reader.fill([](ssize_t) {});
+
+	EXPECT_FALSE(reader.next(&frame));
+
+	ret = ::write(pair.fds[1], "llo", 3);
+	reader.fill([](ssize_t) {});
+
+	ASSERT_TRUE(reader.next(&frame));
+	EXPECT_EQ(__str(frame), "hello");
+}
+
+TEST(FrameReader, Wrap)
+{
+	FramePair pair;
+	FrameReader<ClosingDescriptor, uint32_t, 64> reader(pair.fds[0]);
+	std::span<const uint8_t> frame;
+	string payload;
+	size_t i;
+
+	// Keep a few bytes pending in the ring so it never restarts from
+	// its beginning and the headers and payloads wrap at various offsets.
+	pair.send("x");
+
+	for (i = 0; i < 200; i++) {
+		payload = string(i % 37, static_cast<char> ('a' + i % 26));
+		pair.send(payload);
+		pair.send("x");
+
+		ASSERT_TRUE(reader.read(&frame));
+		ASSERT_EQ(__str(frame), "x");
+		ASSERT_TRUE(reader.read(&frame));
+		ASSERT_EQ(__str(frame), payload);
+		ASSERT_GT(reader.pending(), 0);
+	}
+}
+
+TEST(FrameReader, ShortHeader)
+{
+	FramePair pair;
+	FrameReader<ClosingDescriptor, uint16_t> reader(pair.fds[0]);
+	std::span<const uint8_t> frame;
+	[[maybe_unused]] ssize_t ret;
+
+	ret = ::write(pair.fds[1], "\0\3abc", 5);
+	pair.shutdown();
+
+	ASSERT_TRUE(reader.read(&frame));
+	EXPECT_EQ(__str(frame), "abc");
+	EXPECT_FALSE(reader.read(&frame));
+}
+
+TEST(FrameReader, TooLarge)
+{
+	FramePair pair;
+	FrameReader<ClosingDescriptor, uint32_t, 64> reader(pair.fds[0]);
+	std::span<const uint8_t> frame;
+
+	pair.send(string(61, 'a'));
+
+	EXPECT_THROW(reader.read(&frame), ErrnoException<EMSGSIZE>);
+}
+
+TEST(FrameReader, TruncatedStream)
+{
+	FramePair pair;
+	FrameReader<ClosingDescriptor> reader(pair.fds[0]);
+	std::span<const uint8_t> frame;
+	[[maybe_unused]] ssize_t ret;
+
+	ret = ::write(pair.fds[1], "\0\0\0\5he", 6);
+	pair.shutdown();
+
+	EXPECT_THROW(reader.read(&frame), ErrnoException<EPROTO>);
+}
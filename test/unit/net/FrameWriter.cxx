@@ -0,0 +1,126 @@
+#include <metasys/net/FrameWriter.hxx>
+
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <metasys/net/FrameReader.hxx>
+#include <metasys/sys/ClosingDescriptor.hxx>
+
+
+using metasys::ClosingDescriptor;
+using metasys::FrameReader;
+using metasys::FrameWriter;
+using std::string;
+
+
+static void __socketpair(int *fds)
+{
+	[[maybe_unused]] int ret;
+
+	ret = ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds);
+	assert(ret == 0);
+}
+
+
+TEST(FrameWriter, Header)
+{
+	FrameWriter<ClosingDescriptor, uint16_t> writer;
+	uint8_t buf[16];
+	int fds[2];
+
+	__socketpair(fds);
+	writer.descriptor().reset(fds[1]);
+
+	writer.write("abc", 3);
+	writer.write("", 0);
+
+	ASSERT_EQ(::read(fds[0], buf, sizeof (buf)), 7);
+	EXPECT_EQ(buf[0], 0);
+	EXPECT_EQ(buf[1], 3);
+	EXPECT_EQ(string(reinterpret_cast<char *> (buf + 2), 3), "abc");
+	EXPECT_EQ(buf[5], 0);
+	EXPECT_EQ(buf[6], 0);
+
+	::close(fds[0]);
+}
+
+TEST(FrameWriter, TooLarge)
+{
+	FrameWriter<ClosingDescriptor, uint16_t> writer;
+	string payload(70000, 'x');
+	uint8_t buf[16];
+	int fds[2], ret;
+
+	__socketpair(fds);
+	writer.descriptor().reset(fds[1]);
+
+	ret = writer.write(payload.data(), payload.size(),
+			   [](int r) { return r; });
+
+	EXPECT_EQ(ret, -1);
+	EXPECT_EQ(errno, EMSGSIZE);
+
+	// Nothing was sent so the stream is still usable.
+	writer.write("ok", 2);
+	ASSERT_EQ(::read(fds[0], buf, sizeof (buf)), 4);
+	EXPECT_EQ(string(reinterpret_cast<char *> (buf + 2), 2), "ok");
+
+	::close(fds[0]);
+}
+
+static void *__FrameWriter_sender(void *arg)
+{
+	auto writer = static_cast<FrameWriter<ClosingDescriptor> *> (arg);
+	string payload(1 << 20, 'z');
+
+	payload.front() = 'a';
+	payload.back() = 'b';
+
+	writer->write(payload.data(), payload.size());
+	writer->write("end", 3);
+	writer->descriptor().close();
+
+	return nullptr;
+}
+
+TEST(FrameWriter, LargeFrame)
+{
+	using Reader = FrameReader<ClosingDescriptor, uint32_t, (1 << 21)>;
+
+	FrameWriter<ClosingDescriptor> writer;
+	std::unique_ptr<Reader> reader;
+	std::span<const uint8_t> frame;
+	pthread_t tid;
+	int fds[2];
+
+	__socketpair(fds);
+	writer.descriptor().reset(fds[1]);
+	reader = std::make_unique<Reader>(fds[0]);
+
+	// Larger than the socket buffer: the writer must resume after
+	// partial writes.
+	ASSERT_EQ(::pthread_create(&tid, nullptr, __FrameWriter_sender,
+				   &writer), 0);
+
+	ASSERT_TRUE(reader->read(&frame));
+	EXPECT_EQ(frame.size(), 1u << 20);
+	EXPECT_EQ(frame.front(), 'a');
+	EXPECT_EQ(frame.back(), 'b');
+
+	ASSERT_TRUE(reader->read(&frame));
+	EXPECT_EQ(frame.size(), 3);
+
+	EXPECT_FALSE(reader->read(&frame));
+
+	::pthread_join(tid, nullptr);
+}
@@ -0,0 +1,117 @@
+#include <metasys/net/InetAddress.hxx>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <array>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+
+using metasys::InetAddress;
+
+
+static constexpr InetAddress __constant = InetAddress::localhost(9000);
+
+static_assert (__constant.port() == 9000);
+static_assert (__constant.saddrin()->sin_family == AF_INET);
+
+
+TEST(InetAddress, Default)
+{
+	InetAddress addr;
+
+	EXPECT_EQ(AF_INET, addr.saddrin()->sin_family);
+	EXPECT_EQ(htonl(INADDR_ANY), addr.saddrin()->sin_addr.s_addr);
+	EXPECT_EQ(0, addr.port());
+}
+
+TEST(InetAddress, Port)
+{
+	InetAddress addr = InetAddress(8080);
+
+	EXPECT_EQ(htonl(INADDR_ANY), addr.saddrin()->sin_addr.s_addr);
+	EXPECT_EQ(htons(8080), addr.saddrin()->sin_port);
+	EXPECT_EQ(8080, addr.port());
+}
+
+TEST(InetAddress, Localhost)
+{
+	InetAddress addr = InetAddress::localhost(9000);
+
+	EXPECT_EQ(AF_INET, addr.saddrin()->sin_family);
+	EXPECT_EQ(htonl(INADDR_LOOPBACK), addr.saddrin()->sin_addr.s_addr);
+	EXPECT_EQ(9000, addr.port());
+	EXPECT_EQ(__constant, addr);
+}
+
+TEST(InetAddress, Components)
+{
+	InetAddress addr = InetAddress(10, 1, 2, 3, 443);
+
+	EXPECT_EQ(10, addr.ip()[0]);
+	EXPECT_EQ(1, addr.ip()[1]);
+	EXPECT_EQ(2, addr.ip()[2]);
+	EXPECT_EQ(3, addr.ip()[3]);
+	EXPECT_EQ(443, addr.port());
+}
+
+TEST(InetAddress, Bytes)
+{
+	const uint8_t ip[4] = { 192, 168, 0, 1 };
+	InetAddress addr = InetAddress(ip, 22);
+
+	EXPECT_EQ(InetAddress(192, 168, 0, 1, 22), addr);
+}
+
+TEST(InetAddress, Order)
+{
+	EXPECT_LT(InetAddress(10, 0, 0, 1, 80), InetAddress(10, 0, 0, 2, 80));
+	EXPECT_LT(InetAddress(10, 0, 0, 1, 80), InetAddress(10, 0, 0, 1, 81));
+	EXPECT_GT(InetAddress(11, 0, 0, 0, 1), InetAddress(10, 9, 9, 9, 9));
+}
+
+TEST(InetAddress, FillPeers)
+{
+	const std::array<uint32_t, 3> ips = {
+		INADDR_LOOPBACK, 0x0a000001, 0xc0a80101
+	};
+	const std::array<uint16_t, 3> ports = { 9000, 80, 65535 };
+	std::array<InetAddress, 3> addrs;
+
+	InetAddress::fill(addrs, ips, ports);
+
+	EXPECT_EQ(InetAddress::localhost(9000), addrs[0]);
+	EXPECT_EQ(InetAddress(10, 0, 0, 1, 80), addrs[1]);
+	EXPECT_EQ(InetAddress(192, 168, 1, 1, 65535), addrs[2]);
+
+	for (const InetAddress &addr : addrs)
+		EXPECT_EQ(AF_INET, addr.saddrin()->sin_family);
+}
+
+TEST(InetAddress, FillPorts)
+{
+	std::array<InetAddress, 16> addrs;
+	size_t i;
+
+	InetAddress::fill(addrs, INADDR_LOOPBACK, 7000);
+
+	for (i = 0; i < addrs.size(); i++)
+		EXPECT_EQ(InetAddress::localhost(7000 + i), addrs[i]);
+}
+
+TEST(InetAddress, FillConstant)
+{
+	constexpr std::array<InetAddress, 2> addrs = []() {
+		std::array<InetAddress, 2> ret;
+
+		InetAddress::fill(ret, INADDR_LOOPBACK, 100);
+
+		return ret;
+	}();
+
+	static_assert (addrs[1].port() == 101);
+
+	EXPECT_EQ(InetAddress::localhost(100), addrs[0]);
+}
@@ -0,0 +1,154 @@
+#include <metasys/net/bit.hxx>
+
+#include <arpa/inet.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+
+using metasys::be_uint16_t;
+using metasys::be_uint32_t;
+using metasys::be_uint64_t;
+using metasys::BswapIsa;
+
+
+static std::vector<BswapIsa> __supported_isas()
+{
+	std::vector<BswapIsa> ret = { BswapIsa::Scalar };
+
+	if (metasys::bswapisa() != BswapIsa::Scalar)
+		ret.push_back(BswapIsa::Ssse3);
+	if (metasys::bswapisa() == BswapIsa::Avx2)
+		ret.push_back(BswapIsa::Avx2);
+
+	return ret;
+}
+
+template<typename T>
+static std::vector<T> __pattern(size_t len)
+{
+	std::vector<T> ret(len);
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		ret[i] = static_cast<T> (0x0123456789abcdefull * (i + 1));
+
+	return ret;
+}
+
+template<typename T>
+static void __check_bswap()
+{
+	size_t len, i;
+
+	for (BswapIsa isa : __supported_isas()) {
+		for (len = 0; len < 67; len++) {
+			std::vector<T> src = __pattern<T>(len);
+			std::vector<T> dest(len + 1, 0);
+
+			metasys::bswap(std::span<const T>(src),
+				       std::span<T>(dest), isa);
+
+			for (i = 0; i < len; i++)
+				ASSERT_EQ(dest[i], metasys::bswap(src[i]));
+			ASSERT_EQ(dest[len], 0);
+
+			metasys::bswap(std::span<const T>(dest.data(), len),
+				       std::span<T>(dest.data(), len), isa);
+
+			for (i = 0; i < len; i++)
+				ASSERT_EQ(dest[i], src[i]);
+		}
+	}
+}
+
+
+TEST(bit, BulkBswap16)
+{
+	__check_bswap<uint16_t>();
+}
+
+TEST(bit, BulkBswap32)
+{
+	__check_bswap<uint32_t>();
+}
+
+TEST(bit, BulkBswap64)
+{
+	__check_bswap<uint64_t>();
+}
+
+TEST(bit, BulkHton)
+{
+	std::vector<uint32_t> host = __pattern<uint32_t>(100);
+	std::vector<uint32_t> net(host.size());
+	size_t i;
+
+	metasys::hton(host, net);
+
+	for (i = 0; i < host.size(); i++)
+		EXPECT_EQ(net[i], htonl(host[i]));
+
+	metasys::ntoh(net);
+
+	EXPECT_EQ(net, host);
+}
+
+TEST(bit, BulkConstexpr)
+{
+	constexpr std::array<uint16_t, 3> net = []() {
+		std::array<uint16_t, 3> ret = { 0x0102, 0x0304, 0x0506 };
+
+		metasys::bswap(ret);
+
+		return ret;
+	}();
+
+	static_assert (net[0] == 0x0201);
+	static_assert (net[2] == 0x0605);
+}
+
+TEST(bit, BigEndian)
+{
+	be_uint32_t value = 0x01020304;
+	uint8_t bytes[sizeof (value)];
+
+	std::memcpy(bytes, &value, sizeof (value));
+
+	EXPECT_EQ(bytes[0], 0x01);
+	EXPECT_EQ(bytes[3], 0x04);
+	EXPECT_EQ(value.load(), 0x01020304u);
+	EXPECT_EQ(value.raw(), htonl(0x01020304));
+
+	value = 42;
+
+	EXPECT_EQ(static_cast<uint32_t> (value), 42u);
+}
+
+TEST(bit, BigEndianInPlace)
+{
+	struct Header
+	{
+		be_uint16_t  type;
+		be_uint64_t  length;
+		be_uint32_t  crc;
+	};
+
+	const uint8_t wire[] = {
+		0xff,                                            // padding
+		0x00, 0x07,                                      // type
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,  // length
+		0xde, 0xad, 0xbe, 0xef                           // crc
+	};
+	const Header *header = reinterpret_cast<const Header *> (wire + 1);
+
+	static_assert (sizeof (Header) == 14);
+
+	EXPECT_EQ(header->type, 7);
+	EXPECT_EQ(header->length, 256u);
+	EXPECT_EQ(header->crc, 0xdeadbeefu);
+}
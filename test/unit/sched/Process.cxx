@@ -1,11 +1,17 @@
 #include <metasys/sched/Process.hxx>
 
+#include <fcntl.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
+#include <string>
+
 #include <gtest/gtest.h>
 
 
 using metasys::Process;
+using metasys::ProcessBehavior;
+using std::string;
 
 
 static pid_t __fork_short()
@@ -70,3 +76,85 @@ TEST(Process, ForkInit)
 
 	ASSERT_EQ(::waitpid(pid, NULL, 0), pid);
 }
+
+TEST(Process, CaptureNotEnabled)
+{
+	EXPECT_EQ(sizeof (Process<>), sizeof (pid_t));
+	EXPECT_EQ(sizeof (Process<ProcessBehavior::SUBPROCESS()>),
+		  sizeof (pid_t));
+}
+
+TEST(Process, CaptureFlags)
+{
+	pid_t self = ::getpid();
+	Process p = Process<ProcessBehavior::SERVICE()>::forkinit();
+
+	if (::getpid() != self)
+		::_exit(0);
+
+	ASSERT_TRUE(p.valid());
+
+	EXPECT_TRUE(::fcntl(p.stdin().value(), F_GETFD) & FD_CLOEXEC);
+	EXPECT_TRUE(::fcntl(p.stdout().value(), F_GETFD) & FD_CLOEXEC);
+	EXPECT_TRUE(::fcntl(p.stderr().value(), F_GETFD) & FD_CLOEXEC);
+
+	EXPECT_TRUE(::fcntl(p.stdin().value(), F_GETFL) & O_NONBLOCK);
+	EXPECT_TRUE(::fcntl(p.stdout().value(), F_GETFL) & O_NONBLOCK);
+	EXPECT_TRUE(::fcntl(p.stderr().value(), F_GETFL) & O_NONBLOCK);
+}
+
+TEST(Process, CaptureStdout)
+{
+	Process p = Process<ProcessBehavior::COMMAND()>::forkinit();
+	string out;
+
+	if (p.pid() == 0) {
+		::execlp("echo", "echo", "Hello", NULL);
+		::_exit(127);
+	}
+
+	p.communicate(nullptr, 0, &out);
+
+	EXPECT_EQ(out, "Hello\n");
+}
+
+TEST(Process, CaptureChildBlocking)
+{
+	Process p = Process<ProcessBehavior::COMMAND()>::forkinit();
+	string out;
+
+	if (p.pid() == 0) {
+		int flags = ::fcntl(STDOUT_FILENO, F_GETFL);
+
+		::_exit((flags & O_NONBLOCK) ? 1 : 0);
+	}
+
+	p.communicate();
+
+	int status;
+
+	p.wait(&status);
+
+	ASSERT_TRUE(WIFEXITED(status));
+	EXPECT_EQ(WEXITSTATUS(status), 0);
+
+	p.reset();
+}
+
+TEST(Process, CommunicateLarge)
+{
+	Process p = Process<ProcessBehavior::SERVICE()>::forkinit();
+	string in(1 << 20, 'x');
+	string out, err;
+
+	if (p.pid() == 0) {
+		::execlp("sh", "sh", "-c", "cat; echo done >&2", NULL);
+		::_exit(127);
+	}
+
+	p.communicate(in, &out, &err);
+
+	EXPECT_EQ(out.size(), in.size());
+	EXPECT_EQ(out, in);
+	EXPECT_EQ(err, "done\n");
+}
@@ -0,0 +1,180 @@
+#include <metasys/sched/ProcessPool.hxx>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include <gtest/gtest.h>
+
+
+using metasys::ProcessPool;
+using metasys::WorkerLoad;
+
+
+static void __idle_worker(size_t index, WorkerLoad &load)
+{
+	load.reset(index + 1);
+
+	while (true)
+		::pause();
+}
+
+static bool __wait_loads(const auto &pool)
+{
+	size_t i, retry;
+
+	for (retry = 0; retry < 1000; retry++) {
+		for (i = 0; i < pool.size(); i++)
+			if (pool.load(i) != (i + 1))
+				break;
+
+		if (i == pool.size())
+			return true;
+
+		::usleep(1000);
+	}
+
+	return false;
+}
+
+static bool __pid_is_alive(pid_t pid)
+{
+	return (::kill(pid, 0) == 0);
+}
+
+
+TEST(ProcessPool, Unstarted)
+{
+	ProcessPool pool = ProcessPool(__idle_worker);
+
+	EXPECT_FALSE(pool.valid());
+	EXPECT_EQ(pool.size(), 0);
+}
+
+TEST(ProcessPool, Start)
+{
+	pid_t pids[3];
+	size_t i;
+
+	{
+		ProcessPool pool = ProcessPool(__idle_worker);
+
+		pool.start(3);
+
+		EXPECT_TRUE(pool.valid());
+		ASSERT_EQ(pool.size(), 3);
+
+		for (i = 0; i < 3; i++) {
+			pids[i] = pool.worker(i).pid();
+			EXPECT_GT(pids[i], 0);
+		}
+
+		EXPECT_TRUE(__wait_loads(pool));
+		EXPECT_EQ(pool.leastloaded(), 0);
+	}
+
+	for (i = 0; i < 3; i++)
+		EXPECT_FALSE(__pid_is_alive(pids[i]));
+}
+
+TEST(ProcessPool, ExitCode)
+{
+	ProcessPool pool = ProcessPool([](size_t index, WorkerLoad &) {
+		return static_cast<int> (index) + 10;
+	});
+	int status;
+
+	pool.start(1);
+
+	ASSERT_EQ(::waitpid(pool.worker(0).pid(), &status, 0),
+		  pool.worker(0).pid());
+
+	EXPECT_TRUE(WIFEXITED(status));
+	EXPECT_EQ(WEXITSTATUS(status), 10);
+
+	EXPECT_EQ(pool.respawn(), 1);
+}
+
+TEST(ProcessPool, Respawn)
+{
+	ProcessPool pool = ProcessPool(__idle_worker);
+	pid_t old;
+
+	pool.start(2);
+
+	EXPECT_EQ(pool.respawn(), 0);
+
+	ASSERT_TRUE(__wait_loads(pool));
+
+	old = pool.worker(1).pid();
+	ASSERT_EQ(::kill(old, SIGKILL), 0);
+
+	while (pool.respawn() == 0)
+		::usleep(1000);
+
+	EXPECT_NE(pool.worker(1).pid(), old);
+	EXPECT_TRUE(__wait_loads(pool));
+}
+
+TEST(ProcessPool, RestartAll)
+{
+	ProcessPool pool = ProcessPool(__idle_worker);
+	pid_t old[2];
+	size_t i;
+
+	pool.start(2);
+
+	for (i = 0; i < 2; i++)
+		old[i] = pool.worker(i).pid();
+
+	pool.restartall();
+
+	for (i = 0; i < 2; i++) {
+		EXPECT_NE(pool.worker(i).pid(), old[i]);
+		EXPECT_FALSE(__pid_is_alive(old[i]));
+	}
+
+	EXPECT_TRUE(__wait_loads(pool));
+}
+
+static void StopInterrupted_alarm(int)
+{
+}
+
+TEST(ProcessPool, StopInterrupted)
+{
+	ProcessPool pool = ProcessPool([](size_t index, WorkerLoad &load) {
+		sigset_t set;
+
+		::sigemptyset(&set);
+		::sigaddset(&set, SIGTERM);
+		::sigprocmask(SIG_BLOCK, &set, nullptr);
+
+		load.reset(index + 1);
+		::usleep(200000);
+	});
+	struct sigaction sa = {}, old;
+	pid_t pid;
+
+	pool.start(1);
+	pid = pool.worker(0).pid();
+
+	ASSERT_TRUE(__wait_loads(pool));
+
+	// Interrupt the wait for the worker, which ignores the signal of
+	// stop() and exits later.
+	sa.sa_handler = StopInterrupted_alarm;
+	ASSERT_EQ(::sigaction(SIGALRM, &sa, &old), 0);
+	::ualarm(50000, 0);
+
+	pool.stop();
+
+	EXPECT_FALSE(pool.valid());
+	EXPECT_EQ(::waitpid(pid, nullptr, WNOHANG), -1);
+	EXPECT_EQ(errno, ECHILD);
+
+	::sigaction(SIGALRM, &old, nullptr);
+}
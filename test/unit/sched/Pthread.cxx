@@ -3,6 +3,8 @@
 #include <unistd.h>
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -331,3 +333,50 @@ TEST(Pthread, CreateAndCancelCatch)
 
 	EXPECT_TRUE(CreateAndCancelCatch_ret);
 }
+
+static volatile bool Cputime_spin = true;
+static void Cputime_routine()
+{
+	while (Cputime_spin)
+		;
+}
+
+TEST(Pthread, Cputime)
+{
+	Pthread<void> t;
+	uint64_t first, second;
+
+	t.create(Cputime_routine);
+
+	first = t.cputime();
+
+	while ((second = t.cputime()) < first + 10000000)
+		::usleep(1000);
+
+	Cputime_spin = false;
+	t.join();
+
+	EXPECT_GT(second, first);
+}
+
+TEST(Pthread, SetName)
+{
+	volatile bool state = true;
+	pthread_t tid = __get_idle_thread(&state);
+	char name[16];
+
+	{
+		Pthread t = Pthread(tid);
+
+		t.setname("worker-7");
+
+		EXPECT_EQ(0, ::pthread_getname_np(tid, name, sizeof (name)));
+		EXPECT_STREQ("worker-7", name);
+
+		EXPECT_NE(0, t.setname("a-name-too-long-for-linux",
+				       [](int ret) { return ret; }));
+
+		state = false;
+		t.join();
+	}
+}
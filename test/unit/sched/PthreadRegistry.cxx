@@ -0,0 +1,118 @@
+#include <metasys/sched/PthreadRegistry.hxx>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <metasys/sched/Pthread.hxx>
+
+
+using metasys::Pthread;
+using metasys::PthreadRegistry;
+using metasys::PthreadSample;
+
+
+static const PthreadSample *__find(const std::vector<PthreadSample> &samples,
+				   pthread_t thread)
+{
+	for (const PthreadSample &sample : samples)
+		if (::pthread_equal(sample.thread, thread))
+			return &sample;
+
+	return nullptr;
+}
+
+
+static volatile bool Unlisted_listed = true;
+static void Unlisted_routine()
+{
+	Unlisted_listed = PthreadRegistry::listed();
+}
+
+TEST(PthreadRegistry, Unlisted)
+{
+	Pthread<void> t;
+
+	t.create(Unlisted_routine);
+	t.join();
+
+	EXPECT_FALSE(Unlisted_listed);
+}
+
+TEST(PthreadRegistry, EnlistDelist)
+{
+	char saved[16];
+
+	ASSERT_EQ(0, ::pthread_getname_np(::pthread_self(), saved,
+					  sizeof (saved)));
+
+	PthreadRegistry::enlist();
+
+	EXPECT_TRUE(PthreadRegistry::listed());
+	ASSERT_NE(nullptr, __find(PthreadRegistry::snapshot(),
+				  ::pthread_self()));
+	EXPECT_STREQ(saved, __find(PthreadRegistry::snapshot(),
+				   ::pthread_self())->name);
+	EXPECT_EQ(::gettid(), __find(PthreadRegistry::snapshot(),
+				     ::pthread_self())->tid);
+
+	PthreadRegistry::delist();
+
+	EXPECT_FALSE(PthreadRegistry::listed());
+	EXPECT_EQ(nullptr, __find(PthreadRegistry::snapshot(),
+				  ::pthread_self()));
+}
+
+static constexpr size_t Workers_nthreads = 12;
+static pthread_t Workers_tids[Workers_nthreads];
+static std::atomic<size_t> Workers_ready = 0;
+static std::atomic<bool> Workers_stop = false;
+static void Workers_routine(size_t index)
+{
+	PthreadRegistry::enlist("registry-worker-name");
+	Workers_tids[index] = ::pthread_self();
+	Workers_ready += 1;
+
+	while (Workers_stop.load() == false)
+		;
+}
+
+TEST(PthreadRegistry, Workers)
+{
+	Pthread<void> threads[Workers_nthreads];
+	std::vector<PthreadSample> samples;
+	const PthreadSample *sample;
+	size_t i;
+
+	for (i = 0; i < Workers_nthreads; i++)
+		threads[i].create(Workers_routine, i);
+
+	while (Workers_ready.load() < Workers_nthreads)
+		::usleep(1000);
+
+	samples = PthreadRegistry::snapshot();
+
+	EXPECT_GE(samples.size(), Workers_nthreads);
+
+	for (i = 0; i < Workers_nthreads; i++) {
+		sample = __find(samples, Workers_tids[i]);
+		ASSERT_NE(nullptr, sample);
+		EXPECT_STREQ("registry-worker", sample->name);
+		EXPECT_GT(sample->cputime, 0);
+	}
+
+	Workers_stop = true;
+
+	for (i = 0; i < Workers_nthreads; i++)
+		threads[i].join();
+
+	samples = PthreadRegistry::snapshot();
+
+	for (i = 0; i < Workers_nthreads; i++)
+		EXPECT_EQ(nullptr, __find(samples, Workers_tids[i]));
+}
@@ -0,0 +1,250 @@
+#include <metasys/sched/Rseq.hxx>
+
+#include <sys/rseq.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <metasys/sched/PerCpu.hxx>
+#include <metasys/sched/PerCpuFreeList.hxx>
+#include <metasys/sched/Pthread.hxx>
+#include <metasys/sched/ShardedCounter.hxx>
+
+
+using metasys::PerCpu;
+using metasys::PerCpuFreeList;
+using metasys::Pthread;
+using metasys::Rseq;
+using metasys::ShardedCounter;
+using metasys::ShardedHistogram;
+
+
+static constexpr size_t __nthreads = 32;
+
+
+TEST(Rseq, Area)
+{
+	struct rseq *area = Rseq::area();
+
+	if (area == nullptr)
+		GTEST_SKIP() << "restartable sequences not available";
+
+	EXPECT_EQ(area, Rseq::area());
+	EXPECT_LT(Rseq::cpu(area), PerCpu<uint64_t>::cpus());
+}
+
+TEST(Rseq, TryAdd)
+{
+	struct rseq *area = Rseq::area();
+	PerCpu<uint64_t> counters;
+	uint64_t sum = 0;
+	uint32_t cpu;
+	size_t i;
+
+	if (area == nullptr)
+		GTEST_SKIP() << "restartable sequences not available";
+
+	do {
+		cpu = Rseq::cpu(area);
+	} while (Rseq::tryadd(area, cpu, &counters[cpu], 42) == false);
+
+	for (i = 0; i < counters.size(); i++)
+		sum += counters[i];
+
+	EXPECT_EQ(42, sum);
+}
+
+static constexpr uint64_t Hammer_iterations = 200000;
+static PerCpu<uint64_t> *Hammer_counters;
+static ShardedCounter *Hammer_sharded;
+static std::atomic<bool> Hammer_go = false;
+static void Hammer_routine()
+{
+	struct rseq *area = Rseq::area();
+	uint32_t cpu;
+	uint64_t i;
+
+	while (Hammer_go.load() == false)
+		;
+
+	for (i = 0; i < Hammer_iterations; i++) {
+		do {
+			cpu = Rseq::cpu(area);
+		} while (Rseq::tryadd(area, cpu, &(*Hammer_counters)[cpu], 1)
+			 == false);
+
+		Hammer_sharded->add(2);
+	}
+}
+
+TEST(Rseq, HammerCounter)
+{
+	Pthread<void> threads[__nthreads];
+	PerCpu<uint64_t> counters;
+	ShardedCounter sharded;
+	uint64_t sum = 0;
+	size_t i;
+
+	if (Rseq::area() == nullptr)
+		GTEST_SKIP() << "restartable sequences not available";
+
+	Hammer_counters = &counters;
+	Hammer_sharded = &sharded;
+
+	for (i = 0; i < __nthreads; i++)
+		threads[i].create(Hammer_routine);
+
+	Hammer_go = true;
+
+	for (i = 0; i < __nthreads; i++)
+		threads[i].join();
+
+	for (i = 0; i < counters.size(); i++)
+		sum += counters[i];
+
+	EXPECT_EQ(__nthreads * Hammer_iterations, sum);
+	EXPECT_EQ(2 * __nthreads * Hammer_iterations, sharded.load());
+}
+
+struct FreeList_Node
+{
+	FreeList_Node         *next;
+	std::atomic<size_t>   owner;
+};
+
+static constexpr size_t FreeList_nnodes = 256;
+static constexpr uint64_t FreeList_iterations = 20000;
+static PerCpuFreeList *FreeList_list;
+static std::atomic<size_t> FreeList_errors = 0;
+static void FreeList_routine(size_t index)
+{
+	FreeList_Node *held[4];
+	size_t n, j;
+	uint64_t i;
+
+	for (i = 0; i < FreeList_iterations; i++) {
+		for (n = 0; n < 4; n++) {
+			held[n] = static_cast<FreeList_Node *>
+				(FreeList_list->pop());
+			if (held[n] == nullptr)
+				break;
+			if (held[n]->owner.exchange(index + 1) != 0)
+				FreeList_errors += 1;
+		}
+
+		for (j = 0; j < n; j++) {
+			held[j]->owner.store(0);
+			FreeList_list->push(held[j]);
+		}
+	}
+}
+
+TEST(Rseq, HammerFreeList)
+{
+	std::vector<FreeList_Node> nodes = std::vector<FreeList_Node>
+		(FreeList_nnodes);
+	Pthread<void> threads[__nthreads];
+	PerCpuFreeList list;
+	std::vector<size_t> seen = std::vector<size_t> (FreeList_nnodes);
+	size_t i;
+
+	for (i = 0; i < FreeList_nnodes; i++)
+		list.push(&nodes[i]);
+
+	FreeList_list = &list;
+
+	for (i = 0; i < __nthreads; i++)
+		threads[i].create(FreeList_routine, i);
+	for (i = 0; i < __nthreads; i++)
+		threads[i].join();
+
+	EXPECT_EQ(0, FreeList_errors.load());
+
+	list.clear([&nodes, &seen](void *node) {
+		seen[static_cast<FreeList_Node *> (node) - nodes.data()] += 1;
+	});
+
+	for (i = 0; i < FreeList_nnodes; i++)
+		EXPECT_EQ(1, seen[i]);
+
+	EXPECT_EQ(nullptr, list.pop());
+}
+
+static PerCpuFreeList *Unregistered_list;
+static ShardedCounter *Unregistered_counter;
+static ShardedHistogram<2> *Unregistered_histogram;
+static FreeList_Node Unregistered_node;
+static bool Unregistered_done = false;
+static bool Unregistered_noarea = false;
+static void *Unregistered_popped = nullptr;
+static void Unregistered_routine()
+{
+	struct rseq *area = Rseq::area();
+
+	// Act as a thread glibc failed to register.
+	if (::syscall(SYS_rseq, area, sizeof (*area), RSEQ_FLAG_UNREGISTER,
+		      RSEQ_SIG) != 0)
+		return;
+
+	area->cpu_id = static_cast<uint32_t> (RSEQ_CPU_ID_REGISTRATION_FAILED);
+
+	Unregistered_done = true;
+	Unregistered_noarea = (Rseq::area() == nullptr);
+
+	Unregistered_counter->add(3);
+	Unregistered_histogram->add(1, 5);
+
+	Unregistered_list->push(&Unregistered_node);
+	Unregistered_popped = Unregistered_list->pop();
+	Unregistered_list->push(&Unregistered_node);
+}
+
+TEST(Rseq, Unregistered)
+{
+	FreeList_Node node;
+	PerCpuFreeList list;
+	ShardedCounter counter;
+	ShardedHistogram<2> histogram;
+	Pthread<void> thread;
+	size_t seen = 0;
+
+	if ((__rseq_size == 0) || (Rseq::enabled() == false))
+		GTEST_SKIP() << "restartable sequences not registered by glibc";
+
+	Unregistered_list = &list;
+	Unregistered_counter = &counter;
+	Unregistered_histogram = &histogram;
+
+	list.push(&node);
+	counter.add(1);
+	histogram.add(1, 1);
+
+	thread.create(Unregistered_routine);
+	thread.join();
+
+	if (Unregistered_done == false)
+		GTEST_SKIP() << "cannot unregister restartable sequences";
+
+	EXPECT_TRUE(Unregistered_noarea);
+	EXPECT_EQ(&Unregistered_node, Unregistered_popped);
+
+	EXPECT_EQ(4, counter.load());
+	EXPECT_EQ(0, histogram.load(0));
+	EXPECT_EQ(6, histogram.load(1));
+
+	EXPECT_EQ(&node, list.pop());
+	EXPECT_EQ(nullptr, list.pop());
+
+	list.clear([&seen](void *n) {
+		EXPECT_EQ(&Unregistered_node, n);
+		seen += 1;
+	});
+
+	EXPECT_EQ(1, seen);
+}
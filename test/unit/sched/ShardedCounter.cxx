@@ -0,0 +1,91 @@
+#include <metasys/sched/ShardedCounter.hxx>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <metasys/sched/PerCpu.hxx>
+#include <metasys/sched/Pthread.hxx>
+
+
+using metasys::PerCpu;
+using metasys::Pthread;
+using metasys::ShardedCounter;
+using metasys::ShardedHistogram;
+
+
+TEST(PerCpu, Size)
+{
+	PerCpu<uint64_t> slots;
+
+	EXPECT_EQ(PerCpu<uint64_t>::cpus(), slots.size());
+	EXPECT_LT(PerCpu<uint64_t>::cpu(), slots.size());
+}
+
+TEST(PerCpu, Separate)
+{
+	PerCpu<char> slots = PerCpu<char>(2);
+
+	EXPECT_GE(&slots[1] - &slots[0], 64);
+	EXPECT_EQ(0, slots[0]);
+	EXPECT_EQ(0, slots[1]);
+}
+
+TEST(PerCpu, LocalFewerSlots)
+{
+	PerCpu<uint64_t> slots = PerCpu<uint64_t>(1);
+
+	slots.local() += 1;
+
+	EXPECT_EQ(1, slots[0]);
+}
+
+TEST(ShardedCounter, Add)
+{
+	ShardedCounter counter;
+
+	EXPECT_EQ(0, counter.load());
+
+	counter.add();
+	counter.add(41);
+
+	EXPECT_EQ(42, counter.load());
+}
+
+static constexpr size_t Threads_nthreads = 8;
+static constexpr uint64_t Threads_iterations = 100000;
+static ShardedCounter Threads_counter;
+static ShardedHistogram<4> Threads_histogram;
+static void Threads_routine(size_t index)
+{
+	uint64_t i;
+
+	for (i = 0; i < Threads_iterations; i++) {
+		Threads_counter.add();
+		Threads_histogram.add(index % 4);
+	}
+}
+
+TEST(ShardedCounter, Threads)
+{
+	Pthread<void> threads[Threads_nthreads];
+	std::array<uint64_t, 4> buckets;
+	size_t i;
+
+	for (i = 0; i < Threads_nthreads; i++)
+		threads[i].create(Threads_routine, i);
+	for (i = 0; i < Threads_nthreads; i++)
+		threads[i].join();
+
+	EXPECT_EQ(Threads_nthreads * Threads_iterations,
+		  Threads_counter.load());
+
+	buckets = Threads_histogram.load();
+
+	for (i = 0; i < 4; i++) {
+		EXPECT_EQ(2 * Threads_iterations, buckets[i]);
+		EXPECT_EQ(2 * Threads_iterations, Threads_histogram.load(i));
+	}
+}
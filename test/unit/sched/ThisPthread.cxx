@@ -0,0 +1,79 @@
+#include <metasys/sched/ThisPthread.hxx>
+
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+
+using metasys::PthreadUsage;
+using metasys::ThisPthread;
+
+
+TEST(ThisPthread, Cputime)
+{
+	uint64_t first, second;
+
+	first = ThisPthread::cputime();
+
+	while ((second = ThisPthread::cputime()) < first + 10000000)
+		;
+
+	EXPECT_GE(second, first + 10000000);
+}
+
+TEST(ThisPthread, UsageFaults)
+{
+	const size_t len = 64 * 4096;
+	PthreadUsage before, after;
+	char *area;
+
+	before = ThisPthread::usage();
+
+	area = static_cast<char *>
+		(::mmap(NULL, len, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+	ASSERT_NE(MAP_FAILED, area);
+	std::memset(area, 1, len);
+	::munmap(area, len);
+
+	after = ThisPthread::usage();
+
+	EXPECT_GE(after.minorfaults, before.minorfaults + 64);
+	EXPECT_GE(after.usertime + after.systemtime,
+		  before.usertime + before.systemtime);
+}
+
+TEST(ThisPthread, UsageSwitches)
+{
+	PthreadUsage before, after;
+
+	before = ThisPthread::usage();
+	::usleep(1000);
+	after = ThisPthread::usage();
+
+	EXPECT_GT(after.voluntaryswitches, before.voluntaryswitches);
+}
+
+TEST(ThisPthread, SetName)
+{
+	char name[16], saved[16];
+
+	ASSERT_EQ(0, ::pthread_getname_np(::pthread_self(), saved,
+					  sizeof (saved)));
+
+	ThisPthread::setname("unit-test");
+
+	EXPECT_EQ(0, ::pthread_getname_np(::pthread_self(), name,
+					  sizeof (name)));
+	EXPECT_STREQ("unit-test", name);
+
+	EXPECT_NE(0, ThisPthread::setname("a-name-too-long-for-linux",
+					  [](int ret) { return ret; }));
+
+	ThisPthread::setname(saved);
+}
@@ -0,0 +1,129 @@
+#include <metasys/sched/ThreadLocal.hxx>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <metasys/sched/Pthread.hxx>
+
+
+using metasys::Pthread;
+using metasys::ThreadLocal;
+
+
+struct Tracked
+{
+	static inline int  alive = 0;
+
+	uint64_t  value;
+
+	Tracked() noexcept
+		: value(0)
+	{
+		alive += 1;
+	}
+
+	~Tracked()
+	{
+		alive -= 1;
+	}
+};
+
+
+TEST(ThreadLocal, SameThread)
+{
+	ThreadLocal<uint64_t> local;
+
+	EXPECT_EQ(0, *local);
+
+	*local = 42;
+
+	EXPECT_EQ(42, local.get());
+}
+
+TEST(ThreadLocal, Instances)
+{
+	ThreadLocal<uint64_t> first, second;
+
+	*first = 1;
+	*second = 2;
+
+	EXPECT_EQ(1, *first);
+	EXPECT_EQ(2, *second);
+}
+
+static ThreadLocal<Tracked> *Join_local;
+static volatile uint64_t Join_seen = 1;
+static void Join_routine()
+{
+	Join_seen = (*Join_local)->value;
+	(*Join_local)->value = 7;
+}
+
+TEST(ThreadLocal, DestroyedOnJoin)
+{
+	Pthread<void> t;
+
+	{
+		ThreadLocal<Tracked> local;
+
+		Join_local = &local;
+		local->value = 3;
+
+		t.create(Join_routine);
+		t.join();
+
+		EXPECT_EQ(0, Join_seen);
+		EXPECT_EQ(3, local->value);
+		EXPECT_EQ(1, Tracked::alive);
+	}
+
+	EXPECT_EQ(0, Tracked::alive);
+}
+
+static constexpr size_t Foreach_nthreads = 4;
+static ThreadLocal<uint64_t> Foreach_local;
+static Pthread<void> Foreach_threads[Foreach_nthreads];
+static std::atomic<size_t> Foreach_ready = 0;
+static volatile bool Foreach_stop = false;
+static void Foreach_routine(size_t index)
+{
+	*Foreach_local = index + 1;
+	Foreach_ready += 1;
+
+	while (Foreach_stop == false)
+		;
+}
+
+TEST(ThreadLocal, Foreach)
+{
+	uint64_t sum = 0;
+	size_t count = 0;
+	size_t i;
+
+	for (i = 0; i < Foreach_nthreads; i++)
+		Foreach_threads[i].create(Foreach_routine, i);
+
+	while (Foreach_ready.load() < Foreach_nthreads)
+		;
+
+	Foreach_local.foreach([&sum, &count](uint64_t value) {
+		sum += value;
+		count += 1;
+	});
+
+	Foreach_stop = true;
+
+	for (i = 0; i < Foreach_nthreads; i++)
+		Foreach_threads[i].join();
+
+	EXPECT_EQ(Foreach_nthreads, count);
+	EXPECT_EQ(1 + 2 + 3 + 4, sum);
+
+	count = 0;
+	Foreach_local.foreach([&count](uint64_t) { count += 1; });
+
+	EXPECT_EQ(0, count);
+}
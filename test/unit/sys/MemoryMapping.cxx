@@ -0,0 +1,140 @@
+#include <metasys/sys/MemoryMapping.hxx>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+
+#include <gtest/gtest.h>
+
+#include <metasys/sys/ClosingDescriptor.hxx>
+#include <metasys/sys/SystemException.hxx>
+
+
+using metasys::ClosingDescriptor;
+using metasys::MemoryMapping;
+using metasys::SystemException;
+using std::span;
+
+
+static ClosingDescriptor __make_file(size_t len)
+{
+	char path[] = "/tmp/metasys-test-XXXXXX";
+	int fd = ::mkstemp(path);
+	size_t i;
+
+	assert(fd >= 0);
+	::unlink(path);
+
+	for (i = 0; i < len; i++) {
+		uint8_t c = static_cast<uint8_t> (i);
+
+		assert(::write(fd, &c, 1) == 1);
+	}
+
+	return ClosingDescriptor(fd);
+}
+
+
+TEST(MemoryMapping, Default)
+{
+	MemoryMapping mm;
+
+	EXPECT_FALSE(mm.valid());
+	EXPECT_EQ(mm.size(), 0);
+}
+
+TEST(MemoryMapping, MapFile)
+{
+	ClosingDescriptor fd = __make_file(10000);
+	MemoryMapping mm = MemoryMapping::mapinit(fd);
+	span<const uint8_t> bytes = mm.span<const uint8_t>();
+	size_t i;
+
+	ASSERT_TRUE(mm.valid());
+	ASSERT_EQ(mm.size(), 10000);
+	ASSERT_EQ(bytes.size(), 10000);
+
+	mm.advise(MemoryMapping::SEQUENTIAL);
+	mm.advise(0, 4096, MemoryMapping::WILLNEED);
+
+	for (i = 0; i < bytes.size(); i++)
+		ASSERT_EQ(bytes[i], static_cast<uint8_t> (i));
+
+	EXPECT_EQ(mm.span<const uint32_t>().size(), 2500);
+}
+
+TEST(MemoryMapping, Populate)
+{
+	ClosingDescriptor fd = __make_file(4096);
+	MemoryMapping mm;
+
+	mm.map(4096, PROT_READ, MAP_PRIVATE | MemoryMapping::POPULATE, fd,
+	       0, [](void *ret) {
+		       EXPECT_NE(ret, MAP_FAILED);
+	       });
+
+	EXPECT_EQ(mm.span<const uint8_t>()[42], 42);
+}
+
+TEST(MemoryMapping, SyncShared)
+{
+	ClosingDescriptor fd = __make_file(4096);
+	MemoryMapping mm = MemoryMapping::mapinit(fd, PROT_READ | PROT_WRITE);
+	uint8_t c;
+
+	mm.span<uint8_t>()[7] = 0xff;
+	mm.sync();
+
+	ASSERT_EQ(::pread(fd.value(), &c, 1, 7), 1);
+	EXPECT_EQ(c, 0xff);
+}
+
+TEST(MemoryMapping, Remap)
+{
+	MemoryMapping mm = MemoryMapping::mapinit(4096, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS);
+
+	std::memset(mm.data(), 0x5a, 4096);
+
+	mm.remap(1 << 20);
+
+	ASSERT_EQ(mm.size(), 1 << 20);
+	EXPECT_EQ(mm.span<uint8_t>()[4095], 0x5a);
+	EXPECT_EQ(mm.span<uint8_t>()[(1 << 20) - 1], 0);
+
+	mm.advise(MemoryMapping::HUGEPAGE, [](int) {});
+}
+
+TEST(MemoryMapping, Move)
+{
+	MemoryMapping a = MemoryMapping::mapinit(4096, PROT_READ,
+		MAP_PRIVATE | MAP_ANONYMOUS);
+	void *addr = a.data();
+	MemoryMapping b = std::move(a);
+
+	EXPECT_FALSE(a.valid());
+	EXPECT_EQ(b.data(), addr);
+
+	a = std::move(b);
+
+	EXPECT_TRUE(a.valid());
+	EXPECT_FALSE(b.valid());
+}
+
+TEST(MemoryMapping, Failure)
+{
+	ClosingDescriptor fd = __make_file(0);
+	MemoryMapping mm;
+
+	EXPECT_EQ(mm.map(fd, PROT_READ, MAP_SHARED, [](void *ret) {
+		return ret;
+	}), MAP_FAILED);
+	EXPECT_FALSE(mm.valid());
+
+	EXPECT_THROW(mm.map(fd), SystemException);
+}
@@ -0,0 +1,102 @@
+#include <metasys/sys/Result.hxx>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include <gtest/gtest.h>
+
+#include <metasys/io/ReadableDescriptor.hxx>
+#include <metasys/sched/Pthread.hxx>
+#include <metasys/sys/ErrnoException.hxx>
+
+
+using metasys::asresult;
+using metasys::ascoderesult;
+using metasys::Errno;
+using metasys::ErrnoException;
+using metasys::Pthread;
+using metasys::ReadableDescriptor;
+using metasys::Result;
+
+
+TEST(Result, Success)
+{
+	Result<ssize_t> ret = Result<ssize_t>::success(12);
+
+	EXPECT_TRUE(ret.has_value());
+	EXPECT_TRUE(ret);
+	EXPECT_EQ(*ret, 12);
+	EXPECT_EQ(ret.value(), 12);
+	EXPECT_EQ(ret.value_or(3), 12);
+}
+
+TEST(Result, Failure)
+{
+	Result<int> ret = Result<int>::failure(Errno(ENOENT));
+
+	EXPECT_FALSE(ret.has_value());
+	EXPECT_FALSE(ret);
+	EXPECT_EQ(ret.error(), ENOENT);
+	EXPECT_EQ(ret.value_or(3), 3);
+	EXPECT_THROW(ret.value(), ErrnoException<ENOENT>);
+}
+
+TEST(Result, ReadSuccess)
+{
+	int fds[2];
+	char c = 'x';
+
+	ASSERT_EQ(::pipe(fds), 0);
+	ASSERT_EQ(::write(fds[1], &c, 1), 1);
+
+	{
+		ReadableDescriptor fd = ReadableDescriptor(fds[0]);
+		Result<ssize_t> ret = fd.read(&c, 1, asresult);
+
+		ASSERT_TRUE(ret);
+		EXPECT_EQ(*ret, 1);
+	}
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+TEST(Result, ReadFailure)
+{
+	int fds[2];
+	char c;
+
+	ASSERT_EQ(::pipe2(fds, O_NONBLOCK), 0);
+
+	{
+		ReadableDescriptor fd = ReadableDescriptor(fds[0]);
+		Result<ssize_t> ret = fd.read(&c, 1, asresult);
+
+		ASSERT_FALSE(ret);
+		EXPECT_EQ(ret.error(), EAGAIN);
+	}
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+static void *__ResultPthread_routine(void *)
+{
+	return nullptr;
+}
+
+TEST(Result, CodeResult)
+{
+	Pthread<void *> thread;
+	Result<int> ret = thread.create(__ResultPthread_routine, nullptr,
+					ascoderesult);
+
+	ASSERT_TRUE(ret);
+	EXPECT_EQ(*ret, 0);
+
+	thread.join();
+
+	EXPECT_EQ(ascoderesult(EAGAIN).error(), EAGAIN);
+}
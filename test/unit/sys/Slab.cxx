@@ -0,0 +1,189 @@
+#include <metasys/sys/Slab.hxx>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include <metasys/sched/EpollDescriptor.hxx>
+#include <metasys/sys/Arena.hxx>
+
+
+using metasys::Arena;
+using metasys::EpollDescriptor;
+using metasys::EpollEvent;
+using metasys::Slab;
+
+
+struct Connection
+{
+	static inline int  alive = 0;
+
+	int        fd;
+	Arena<256> arena;
+
+	explicit Connection(int fd)
+		: fd(fd)
+	{
+		alive += 1;
+	}
+
+	~Connection()
+	{
+		alive -= 1;
+	}
+};
+
+
+TEST(Slab, CreateGet)
+{
+	Slab<Connection> slab = Slab<Connection>(4);
+	Slab<Connection>::Handle a, b;
+
+	a = slab.create(3);
+	b = slab.create(4);
+
+	ASSERT_NE(a, Slab<Connection>::INVALID);
+	ASSERT_NE(b, Slab<Connection>::INVALID);
+	EXPECT_EQ(slab.size(), 2);
+	EXPECT_EQ(slab.get(a)->fd, 3);
+	EXPECT_EQ(slab.get(b)->fd, 4);
+	EXPECT_EQ(slab.handle(slab.get(b)), b);
+	EXPECT_EQ(slab.get(Slab<Connection>::INVALID), nullptr);
+}
+
+TEST(Slab, Full)
+{
+	Slab<int> slab = Slab<int>(2);
+
+	EXPECT_NE(slab.create(1), Slab<int>::INVALID);
+	EXPECT_NE(slab.create(2), Slab<int>::INVALID);
+	EXPECT_EQ(slab.create(3), Slab<int>::INVALID);
+}
+
+TEST(Slab, StaleHandle)
+{
+	Slab<Connection> slab = Slab<Connection>(1);
+	Slab<Connection>::Handle first, second;
+	Connection *ptr;
+
+	first = slab.create(7);
+	ptr = slab.get(first);
+
+	EXPECT_TRUE(slab.destroy(first));
+	EXPECT_EQ(slab.get(first), nullptr);
+	EXPECT_FALSE(slab.destroy(first));
+
+	// Same slot, same address, but the old handle remains stale.
+	second = slab.create(8);
+
+	EXPECT_EQ(slab.get(second), ptr);
+	EXPECT_NE(second, first);
+	EXPECT_EQ(slab.get(first), nullptr);
+}
+
+TEST(Slab, InvalidHandle)
+{
+	Slab<Connection> slab = Slab<Connection>(1);
+	Slab<Connection>::Handle handle;
+
+	EXPECT_EQ(slab.get(Slab<Connection>::INVALID), nullptr);
+	EXPECT_FALSE(slab.destroy(Slab<Connection>::INVALID));
+	EXPECT_EQ(slab.size(), 0);
+
+	handle = slab.create(7);
+	EXPECT_TRUE(slab.destroy(handle));
+
+	// The dead slot now has generation 2.
+	handle = (handle >> 32 << 32) + (1ul << 32);
+	EXPECT_EQ(slab.get(handle), nullptr);
+	EXPECT_FALSE(slab.destroy(handle));
+	EXPECT_EQ(slab.size(), 0);
+}
+
+TEST(Slab, DestroyOnDelete)
+{
+	{
+		Slab<Connection> slab = Slab<Connection>(8);
+
+		slab.create(1);
+		slab.create(2);
+		slab.destroy(slab.get(slab.create(3)));
+
+		EXPECT_EQ(Connection::alive, 2);
+	}
+
+	EXPECT_EQ(Connection::alive, 0);
+}
+
+TEST(Slab, EpollStaleEvent)
+{
+	Slab<Connection> slab = Slab<Connection>(1);
+	EpollDescriptor epoll = EpollDescriptor::createinit();
+	EpollEvent<uint64_t> events[1];
+	Slab<Connection>::Handle handle;
+	int fds[2];
+
+	ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+	handle = slab.create(fds[0]);
+	epoll.add(fds[0], EpollEvent<uint64_t>(EPOLLIN, handle));
+	ASSERT_EQ(::write(fds[1], "x", 1), 1);
+
+	ASSERT_EQ(epoll.wait(events, 1, -1), 1);
+
+	// The connection is closed before the event is processed and its
+	// slot is reused by a new one.
+	slab.destroy(handle);
+	slab.create(-1);
+
+	EXPECT_EQ(slab.get(events[0].data()), nullptr);
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+TEST(Arena, Allocate)
+{
+	Arena<64> arena;
+	void *a, *b;
+
+	a = arena.allocate(10, 1);
+	b = arena.allocate(8, 8);
+
+	ASSERT_NE(a, nullptr);
+	ASSERT_NE(b, nullptr);
+	EXPECT_EQ(reinterpret_cast<uintptr_t> (b) % 8, 0);
+	EXPECT_EQ(arena.used(), 24);
+
+	EXPECT_EQ(arena.allocate(64), nullptr);
+	EXPECT_NE(arena.create<uint64_t>(42), nullptr);
+
+	arena.reset();
+
+	EXPECT_EQ(arena.used(), 0);
+	EXPECT_NE(arena.allocate(64), nullptr);
+	EXPECT_EQ(arena.allocate(1), nullptr);
+}
+
+TEST(Arena, Overaligned)
+{
+	Arena<2048> arena;
+	void *ptr;
+	size_t i;
+
+	for (i = 0; i < 8; i++) {
+		ASSERT_NE(arena.allocate(1 + i * 16, 1), nullptr);
+
+		ptr = arena.allocate(8, 64);
+
+		ASSERT_NE(ptr, nullptr);
+		EXPECT_EQ(reinterpret_cast<uintptr_t> (ptr) % 64, 0);
+	}
+
+	EXPECT_LE(arena.used(), arena.capacity());
+}
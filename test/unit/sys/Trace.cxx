@@ -0,0 +1,105 @@
+#include <metasys/sys/Trace.hxx>
+
+#include <cerrno>
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+
+using metasys::TracePoint;
+using metasys::TraceSnapshot;
+using metasys::TraceStats;
+
+
+TEST(TraceStats, Bucket)
+{
+	uint64_t ns;
+
+	for (ns = 0; ns < 16; ns++)
+		EXPECT_EQ(TraceStats::bucket(ns), ns);
+
+	EXPECT_EQ(TraceStats::bucket(16), 16);
+	EXPECT_EQ(TraceStats::bucket(17), 16);
+	EXPECT_EQ(TraceStats::bucket(18), 17);
+	EXPECT_EQ(TraceStats::bucket(32), 24);
+	EXPECT_LT(TraceStats::bucket(UINT64_MAX), TraceStats::BUCKETS);
+}
+
+TEST(TraceStats, Lowest)
+{
+	uint64_t ns;
+	size_t b;
+
+	for (b = 0; b < TraceStats::BUCKETS; b++)
+		EXPECT_EQ(TraceStats::bucket(TraceStats::lowest(b)), b);
+
+	for (ns = 1; ns < (1ul << 40); ns = ns * 3 + 1) {
+		b = TraceStats::bucket(ns);
+		EXPECT_LE(TraceStats::lowest(b), ns);
+		EXPECT_GT(TraceStats::lowest(b) + TraceStats::lowest(b) / 8
+			  + 1, ns);
+	}
+}
+
+TEST(TraceStats, Percentile)
+{
+	TraceStats stats = {};
+
+	EXPECT_EQ(stats.percentile(0.5), 0);
+
+	stats.calls = 100;
+	stats.histogram[TraceStats::bucket(10)] = 90;
+	stats.histogram[TraceStats::bucket(1000)] = 9;
+	stats.histogram[TraceStats::bucket(100000)] = 1;
+
+	EXPECT_EQ(stats.percentile(0.5), 10);
+	EXPECT_EQ(stats.percentile(0.9),
+		  TraceStats::lowest(TraceStats::bucket(1000)));
+	EXPECT_EQ(stats.percentile(0.99),
+		  TraceStats::lowest(TraceStats::bucket(100000)));
+}
+
+TEST(TraceSnapshot, Name)
+{
+	EXPECT_STREQ(TraceSnapshot::name(TracePoint::Read), "read");
+	EXPECT_STREQ(TraceSnapshot::name(TracePoint::EpollWait),
+		     "epoll_wait");
+}
+
+TEST(TraceSnapshot, Traced)
+{
+	uint64_t before, after;
+	int ret;
+
+	before = metasys::tracesnapshot()[TracePoint::Write].calls;
+
+	ret = metasys::traced<TracePoint::Write>([]() { return -1; });
+
+	after = metasys::tracesnapshot()[TracePoint::Write].calls;
+
+	EXPECT_EQ(ret, -1);
+
+#ifdef METASYS_TRACE
+	EXPECT_EQ(after, before + 1);
+#else
+	EXPECT_EQ(after, before);
+#endif
+}
+
+TEST(TraceSnapshot, TracedErrno)
+{
+	int ret = 0, err = 0;
+
+	// A new thread so the first record also sets its counters up.
+	std::thread([&ret, &err]() {
+		ret = metasys::traced<TracePoint::Read>([]() {
+			errno = EAGAIN;
+			return -1;
+		});
+		err = errno;
+	}).join();
+
+	EXPECT_EQ(ret, -1);
+	EXPECT_EQ(err, EAGAIN);
+}
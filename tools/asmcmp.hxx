@@ -2,6 +2,11 @@
 #define _INCLUDE_ASMTEST_HXX_
 
 
+#ifdef ASMCMP_RUN
+#  include <asmrun.hxx>
+#else
+
+
 static inline void __before_prologue()
 {
 	asm volatile ("cli");
@@ -39,6 +44,12 @@ static inline void __after_epilogue()
 	static inline void __asmtest_ ## name ()			\
 
 
+// Environment a test case needs to be run by the runtime harness (see
+// `asmrun.hxx`), meaningless for the comparison of the instructions.
+//
+#define Environment(name, env)  static_assert (true)
+
+
 #ifdef ASMCMP_STRICT
 #  define Overhead(should, does)  should
 #else
@@ -53,3 +64,4 @@ int main()
 
 
 #endif
+#endif
@@ -0,0 +1,478 @@
+#ifndef _INCLUDE_ASMRUN_HXX_
+#define _INCLUDE_ASMRUN_HXX_
+
+
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <netinet/in.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <x86intrin.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <vector>
+
+
+// Runtime harness for the asmcmp test cases, used when the test sources are
+// compiled with `ASMCMP_RUN` defined.
+// Every `Model` and `Test` of a test case are called alternately many times
+// and the cycles spent in each call are counted, either with the CPU cycles
+// counter of `perf_event_open()` or with `rdtscp` when it is not available.
+// The models are compiled with the `should` side of `Overhead()` so the
+// report shows what the known overheads cost at runtime.
+// Before each call, the standard input is a pipe with a few bytes to read
+// followed by the end of file and the standard output is `/dev/null`.
+// A test case which needs more can declare its `Environment()`.
+//
+
+
+enum class __asmrun_env
+{
+	Default,         // Only the standard input and output.
+	NotRunnable,     // Not meant to be run, e.g. joins an invalid thread.
+	LeaksResources,  // Run fewer times since every call leaks something.
+	LoopbackServer,  // A server accepts connections on the loopback.
+	LoopbackClient,  // A client connects on the loopback.
+};
+
+static constexpr uint16_t __ASMRUN_PORT             = 9000;
+static constexpr size_t   __ASMRUN_ITERATIONS       = 1000;
+static constexpr size_t   __ASMRUN_LEAK_ITERATIONS  = 64;
+static constexpr size_t   __ASMRUN_WARMUP           = 10;
+static constexpr size_t   __ASMRUN_INPUT            = 256;
+
+
+struct __asmrun_entry
+{
+	const char     *name;
+	void          (*model)();
+	void          (*test)();
+	__asmrun_env    env;
+};
+
+static inline std::vector<__asmrun_entry> &__asmrun_registry()
+{
+	static std::vector<__asmrun_entry> registry;
+
+	return registry;
+}
+
+static inline __asmrun_entry &__asmrun_find(const char *name)
+{
+	for (__asmrun_entry &entry : __asmrun_registry())
+		if (strcmp(entry.name, name) == 0)
+			return entry;
+
+	__asmrun_registry().push_back({ name, nullptr, nullptr,
+					__asmrun_env::Default });
+
+	return __asmrun_registry().back();
+}
+
+struct __asmrun_register
+{
+	__asmrun_register(const char *name, void (*model)(), void (*test)())
+	{
+		__asmrun_entry &entry = __asmrun_find(name);
+
+		if (model != nullptr)
+			entry.model = model;
+		if (test != nullptr)
+			entry.test = test;
+	}
+
+	__asmrun_register(const char *name, __asmrun_env env)
+	{
+		__asmrun_find(name).env = env;
+	}
+};
+
+
+#define Model(name)							\
+	static void __asmmodel_ ## name ();				\
+									\
+	static __asmrun_register __asmrun_model_ ## name		\
+		(#name, __asmmodel_ ## name, nullptr);			\
+									\
+	[[gnu::noinline]] static void __asmmodel_ ## name ()		\
+
+
+#define Test(name)							\
+	static void __asmtest_ ## name ();				\
+									\
+	static __asmrun_register __asmrun_test_ ## name			\
+		(#name, nullptr, __asmtest_ ## name);			\
+									\
+	[[gnu::noinline]] static void __asmtest_ ## name ()		\
+
+
+#define Environment(name, env)						\
+	static __asmrun_register __asmrun_env_ ## name			\
+		(#name, __asmrun_env::env)
+
+
+#define Overhead(should, does)  should
+
+
+// Counter of the cycles spent by the calling thread.
+//
+class __asmrun_clock
+{
+	int          _fd;
+	const char  *_name;
+
+
+	static int _open(bool user) noexcept
+	{
+		struct perf_event_attr attr;
+
+		memset(&attr, 0, sizeof (attr));
+		attr.size = sizeof (attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = PERF_COUNT_HW_CPU_CYCLES;
+		attr.exclude_kernel = user;
+		attr.exclude_hv = 1;
+
+		return static_cast<int> (::syscall(SYS_perf_event_open, &attr,
+						   0, -1, -1, 0));
+	}
+
+
+ public:
+	__asmrun_clock() noexcept
+	{
+		if ((_fd = _open(false)) >= 0)
+			_name = "cpu-cycles";
+		else if ((_fd = _open(true)) >= 0)
+			_name = "cpu-cycles:u";
+		else
+			_name = "rdtscp";
+	}
+
+	~__asmrun_clock()
+	{
+		if (_fd >= 0)
+			::close(_fd);
+	}
+
+	const char *name() const noexcept
+	{
+		return _name;
+	}
+
+	uint64_t now() const noexcept
+	{
+		unsigned int aux;
+		uint64_t value;
+
+		if (_fd < 0)
+			return __rdtscp(&aux);
+
+		if (::read(_fd, &value, sizeof (value)) != sizeof (value))
+			return 0;
+
+		return value;
+	}
+};
+
+
+// Server or client running on the loopback while a test case is timed.
+// The connections are closed with a reset so none of them lingers in
+// TIME_WAIT and the test cases can bind or connect again.
+// Both the server and the client wait for the test case to close its side
+// first.  Otherwise the socket of the test case ends in TIME_WAIT, or the
+// reset reaches it before its connect() returns and makes it fail with
+// ECONNRESET.
+//
+class __asmrun_peer
+{
+	__asmrun_env       _env;
+	std::atomic<bool>  _stop;
+	std::thread        _thread;
+	int                _listenfd;
+
+
+	static struct sockaddr_in _address() noexcept
+	{
+		struct sockaddr_in sin = {};
+
+		sin.sin_family = AF_INET;
+		sin.sin_port = htons(__ASMRUN_PORT);
+		sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		return sin;
+	}
+
+	static void _reset(int fd) noexcept
+	{
+		struct linger lin = { 1, 0 };
+
+		::setsockopt(fd, SOL_SOCKET, SO_LINGER, &lin, sizeof (lin));
+		::close(fd);
+	}
+
+	void _serve() noexcept
+	{
+		char c;
+		int fd;
+
+		while ((fd = ::accept4(_listenfd, nullptr, nullptr, 0)) >= 0) {
+			while (::read(fd, &c, sizeof (c)) > 0)
+				;
+			_reset(fd);
+		}
+	}
+
+	void _connect() noexcept
+	{
+		struct sockaddr_in sin = _address();
+		char c;
+		int fd;
+
+		while (_stop.load() == false) {
+			fd = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+			if (::connect(fd, (struct sockaddr *) &sin,
+				      sizeof (sin)) == 0) {
+				while (::read(fd, &c, sizeof (c)) > 0)
+					;
+				_reset(fd);
+			} else {
+				::close(fd);
+				::sched_yield();
+			}
+		}
+	}
+
+
+ public:
+	explicit __asmrun_peer(__asmrun_env env)
+		: _env(env), _stop(false), _listenfd(-1)
+	{
+		struct sockaddr_in sin = _address();
+		int one = 1;
+
+		if (env == __asmrun_env::LoopbackServer) {
+			_listenfd = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+			::setsockopt(_listenfd, SOL_SOCKET, SO_REUSEADDR, &one,
+				     sizeof (one));
+			::bind(_listenfd, (struct sockaddr *) &sin,
+			       sizeof (sin));
+			::listen(_listenfd, SOMAXCONN);
+			_thread = std::thread(&__asmrun_peer::_serve, this);
+		} else if (env == __asmrun_env::LoopbackClient) {
+			_thread = std::thread(&__asmrun_peer::_connect, this);
+		}
+	}
+
+	// Wait for the connections of the last call to be reset so the next
+	// call can bind the port again.
+	//
+	void settle() const noexcept
+	{
+		struct sockaddr_in sin = _address();
+		int fd, ret, tries;
+
+		if (_env != __asmrun_env::LoopbackClient)
+			return;
+
+		for (tries = 0; tries < 100000; tries++) {
+			fd = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+			ret = ::bind(fd, (struct sockaddr *) &sin,
+				     sizeof (sin));
+			::close(fd);
+
+			if (ret == 0)
+				return;
+
+			::sched_yield();
+		}
+	}
+
+	~__asmrun_peer()
+	{
+		_stop.store(true);
+
+		if (_listenfd >= 0)
+			::shutdown(_listenfd, SHUT_RDWR);
+
+		if (_thread.joinable())
+			_thread.join();
+
+		if (_listenfd >= 0)
+			::close(_listenfd);
+	}
+};
+
+
+// Make the standard input a pipe with `__ASMRUN_INPUT` bytes to read then
+// the end of file.
+//
+static inline void __asmrun_prepare() noexcept
+{
+	char buf[__ASMRUN_INPUT];
+	int fds[2];
+
+	if (::pipe(fds) != 0)
+		return;
+
+	memset(buf, 'x', sizeof (buf));
+
+	if (::write(fds[1], buf, sizeof (buf)) < 0)
+		perror("asmrun: write");
+
+	::close(fds[1]);
+	::dup2(fds[0], STDIN_FILENO);
+	::close(fds[0]);
+}
+
+// Reap the children forked by the last call.
+//
+static inline void __asmrun_cleanup() noexcept
+{
+	while (::waitpid(-1, nullptr, WNOHANG) > 0)
+		;
+}
+
+static inline double __asmrun_median(std::vector<uint64_t> &samples)
+{
+	std::sort(samples.begin(), samples.end());
+
+	return static_cast<double> (samples[samples.size() / 2]);
+}
+
+static bool __asmrun_run(FILE *out, const __asmrun_clock &clock,
+			 const __asmrun_entry &entry, size_t iterations)
+{
+	std::vector<uint64_t> samples[2];
+	void (*funcs[2])() = { entry.model, entry.test };
+	double model, test;
+	uint64_t start;
+	size_t i, j, k;
+
+	if (entry.env == __asmrun_env::LeaksResources)
+		iterations = std::min(iterations, __ASMRUN_LEAK_ITERATIONS);
+
+	__asmrun_peer peer = __asmrun_peer(entry.env);
+
+	try {
+		for (i = 0; i < (__ASMRUN_WARMUP + iterations); i++) {
+			// Alternate which side goes first so neither of
+			// them always runs on a warmer cache.
+			for (j = 0; j < 2; j++) {
+				k = (i + j) % 2;
+
+				__asmrun_prepare();
+
+				start = clock.now();
+				funcs[k]();
+				samples[k].push_back(clock.now() - start);
+
+				__asmrun_cleanup();
+				peer.settle();
+			}
+		}
+	} catch (const std::exception &e) {
+		fprintf(out, "%-28s error: %s\n", entry.name, e.what());
+		return false;
+	} catch (...) {
+		fprintf(out, "%-28s error\n", entry.name);
+		return false;
+	}
+
+	for (k = 0; k < 2; k++)
+		samples[k].erase(samples[k].begin(),
+				 samples[k].begin() + __ASMRUN_WARMUP);
+
+	model = __asmrun_median(samples[0]);
+	test = __asmrun_median(samples[1]);
+
+	fprintf(out, "%-28s %12.0f %12.0f %+10.0f %+8.1f%%\n", entry.name,
+		model, test, test - model, (test - model) * 100.0 / model);
+
+	return true;
+}
+
+
+// Usage: <test> [-n <iterations>] [<name-filter>...]
+//
+int main(int argc, const char **argv)
+{
+	std::vector<const char *> filters;
+	size_t iterations = __ASMRUN_ITERATIONS;
+	__asmrun_clock clock;
+	bool selected, ok;
+	FILE *out;
+	char *end;
+	int i, fd;
+
+	for (i = 1; i < argc; i++) {
+		if ((strcmp(argv[i], "-n") == 0) && ((i + 1) < argc)) {
+			iterations = strtoul(argv[++i], &end, 10);
+
+			// The medians need at least one sample.
+			if ((iterations == 0) || (*end != '\0')) {
+				fprintf(stderr, "%s: invalid iterations: '%s'\n",
+					argv[0], argv[i]);
+				return 2;
+			}
+		} else {
+			filters.push_back(argv[i]);
+		}
+	}
+
+	// The test cases print on the standard output and fork children
+	// which flush its buffer when they exit, so report on a separate
+	// stream always kept flushed.
+	out = fdopen(::dup(STDOUT_FILENO), "w");
+	setvbuf(out, nullptr, _IOLBF, 0);
+
+	fd = ::open("/dev/null", O_WRONLY);
+	::dup2(fd, STDOUT_FILENO);
+	::close(fd);
+
+	fprintf(out, "[ %s ] %s, median of %zu calls\n", argv[0],
+		clock.name(), iterations);
+	fprintf(out, "%-28s %12s %12s %10s\n", "test", "model", "test",
+		"overhead");
+
+	ok = true;
+
+	for (const __asmrun_entry &entry : __asmrun_registry()) {
+		if ((entry.model == nullptr) || (entry.test == nullptr))
+			continue;
+		if (entry.env == __asmrun_env::NotRunnable)
+			continue;
+
+		selected = filters.empty();
+
+		for (const char *filter : filters)
+			if (strstr(entry.name, filter) != nullptr)
+				selected = true;
+
+		if (selected)
+			ok = __asmrun_run(out, clock, entry, iterations) && ok;
+	}
+
+	fflush(stdout);
+
+	while (::wait(nullptr) > 0)
+		;
+
+	fprintf(out, "\n");
+
+	return ok ? 0 : 1;
+}
+
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef _INCLUDE_BENCH_HXX_
+#define _INCLUDE_BENCH_HXX_
+
+
+#include <time.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+// Runtime benchmarks comparing metasys against the equivalent libc calls.
+// A benchmark is written once with `Libc(name)` and once with
+// `Metasys(name)`. Both bodies see a `bench` object: they do their setup,
+// call `bench.start()`, run `bench.iterations()` times the operation to
+// measure, then call `bench.stop()` before tearing down.
+// Each body is run several times with a number of iterations calibrated so
+// that a run lasts at least `__BENCH_MIN_NS` and the minimum and median
+// time per iteration are reported.
+//
+
+
+class Bench
+{
+	uint64_t  _iterations;
+	uint64_t  _start;
+	uint64_t  _elapsed;
+
+
+	static uint64_t _now() noexcept
+	{
+		struct timespec ts;
+
+		::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+		return (ts.tv_sec * 1000000000ul + ts.tv_nsec);
+	}
+
+
+ public:
+	explicit Bench(uint64_t iterations) noexcept
+		: _iterations(iterations), _start(0), _elapsed(0)
+	{
+	}
+
+	uint64_t iterations() const noexcept
+	{
+		return _iterations;
+	}
+
+	uint64_t elapsed() const noexcept
+	{
+		return _elapsed;
+	}
+
+	void start() noexcept
+	{
+		_start = _now();
+	}
+
+	void stop() noexcept
+	{
+		_elapsed = _now() - _start;
+	}
+};
+
+
+struct __bench_entry
+{
+	const char  *name;
+	const char  *impl;
+	void       (*func)(Bench &);
+};
+
+static inline std::vector<__bench_entry> &__bench_registry()
+{
+	static std::vector<__bench_entry> registry;
+
+	return registry;
+}
+
+struct __bench_register
+{
+	__bench_register(const char *name, const char *impl,
+			 void (*func)(Bench &))
+	{
+		__bench_registry().push_back({ name, impl, func });
+	}
+};
+
+
+#define __BENCH(name, impl)						\
+	static void __bench_ ## impl ## _ ## name (Bench &);		\
+									\
+	static __bench_register __bench_register_ ## impl ## _ ## name	\
+		(#name, #impl, __bench_ ## impl ## _ ## name);		\
+									\
+	static void __bench_ ## impl ## _ ## name				\
+		([[maybe_unused]] Bench &bench)
+
+
+#define Libc(name)     __BENCH(name, libc)
+#define Metasys(name)  __BENCH(name, metasys)
+
+
+// Prevent the compiler from optimizing away a computed value.
+//
+template<typename T>
+static inline void __bench_keep(const T &value)
+{
+	asm volatile ("" : : "r,m" (value) : "memory");
+}
+
+
+static constexpr uint64_t __BENCH_MIN_NS  = 20000000;
+static constexpr size_t   __BENCH_REPEAT  = 5;
+
+
+static uint64_t __bench_calibrate(const __bench_entry &entry)
+{
+	uint64_t n = 1;
+
+	while (true) {
+		Bench bench = Bench(n);
+
+		entry.func(bench);
+
+		if (bench.elapsed() >= __BENCH_MIN_NS)
+			return n;
+
+		if (bench.elapsed() < (__BENCH_MIN_NS / 100))
+			n *= 100;
+		else
+			n = n * __BENCH_MIN_NS / bench.elapsed() + 1;
+	}
+}
+
+static void __bench_run(const __bench_entry &entry, bool json)
+{
+	double ns[__BENCH_REPEAT];
+	uint64_t n;
+	size_t i;
+
+	n = __bench_calibrate(entry);
+
+	for (i = 0; i < __BENCH_REPEAT; i++) {
+		Bench bench = Bench(n);
+
+		entry.func(bench);
+
+		ns[i] = static_cast<double> (bench.elapsed()) / n;
+	}
+
+	std::sort(ns, ns + __BENCH_REPEAT);
+
+	if (json) {
+		printf("{ \"name\": \"%s\", \"impl\": \"%s\", "
+		       "\"iterations\": %lu, \"min_ns\": %.3f, "
+		       "\"median_ns\": %.3f }\n", entry.name, entry.impl, n,
+		       ns[0], ns[__BENCH_REPEAT / 2]);
+	} else {
+		printf("%-24s %-8s %12.1f ns/op (min %.1f)\n", entry.name,
+		       entry.impl, ns[__BENCH_REPEAT / 2], ns[0]);
+	}
+
+	fflush(stdout);
+}
+
+
+// Usage: <bench> [--json] [<name-filter>...]
+//
+int main(int argc, const char **argv)
+{
+	std::vector<const char *> filters;
+	bool json = false;
+	bool selected;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0)
+			json = true;
+		else
+			filters.push_back(argv[i]);
+	}
+
+	for (const __bench_entry &entry : __bench_registry()) {
+		selected = filters.empty();
+
+		for (const char *filter : filters)
+			if (strstr(entry.name, filter) != nullptr)
+				selected = true;
+
+		if (selected)
+			__bench_run(entry, json);
+	}
+
+	return 0;
+}
+
+
+#endif